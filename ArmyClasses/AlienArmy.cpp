@@ -2,11 +2,17 @@
 
 #include "AlienArmy.h"
 #include "../UnitClasses/Unit.h"
+#include "../Game.h"
 
-AlienArmy::AlienArmy(Game* gamePtr): Army(gamePtr),
+AlienArmy::AlienArmy(Game* gamePtr): Army(gamePtr), infectingProbability(0),
 dronesAddingToggler(false), dronesRemovingToggler(false), dronesPickingToggler(false)
 {}
 
+void AlienArmy::setInfectingProbability(int probability)
+{
+    infectingProbability = probability;
+}
+
 void AlienArmy::addUnit(Unit* unit)
 {
     UnitType unitType = unit->getUnitType();
@@ -44,7 +50,7 @@ Unit* AlienArmy::removeUnit(UnitType unitType)
 
         case UnitType::AM:
             if (!monsters.isEmpty())
-                monsters.remove((rand() % monsters.getCount()), unit); // Remove a random monster
+                monsters.remove(gamePtr->getRandomNumber(0, monsters.getCount() - 1), unit); // Remove a random monster
             break;
 
         case UnitType::AD:
@@ -72,7 +78,7 @@ Unit* AlienArmy::pickAttacker(UnitType unitType)
 
         case UnitType::AM:
             if (!monsters.isEmpty())
-                monsters.entryAt(unit, (rand() % monsters.getCount())); // Pick a random monster
+                monsters.entryAt(unit, gamePtr->getRandomNumber(0, monsters.getCount() - 1)); // Pick a random monster
             break;
 
         case UnitType::AD:
@@ -88,10 +94,9 @@ Unit* AlienArmy::pickAttacker(UnitType unitType)
     return unit;
 }
 
-bool AlienArmy::attack()
+int AlienArmy::pickAttackers(Unit* attackers[])
 {
-    // Flag to check if the army attacked
-    bool didArmyAttack = false;
+    int attackersCount = 0;
 
     UnitType unitTypes[4] = { UnitType::AS, UnitType::AM, UnitType::AD, UnitType::AD };
     for (int i = 0; i < 4; i++)
@@ -105,19 +110,11 @@ bool AlienArmy::attack()
             if (unitTypes[i] == UnitType::AD && drones.getCount() < 2)
                 continue;
 
-            // Attack the enemy
-            bool didUnitAttack = attacker->attack();
-
-            // Add the attacker to the current attackers queue
-            if (didUnitAttack)
-                currentAttackers.enqueue(attacker);
-
-            // If any unit attacked, the army attacked
-            didArmyAttack = didArmyAttack || didUnitAttack;
+            attackers[attackersCount++] = attacker;
         }
     }
 
-    return didArmyAttack; // Return whether the army attacked
+    return attackersCount;
 }
 
 bool AlienArmy::isDead() const
@@ -157,7 +154,12 @@ int AlienArmy::getUnitsCount(UnitType unitType) const
     return 0;
 }
 
-AlienArmy::~AlienArmy()
+int AlienArmy::getInfectingProbability() const
+{
+    return infectingProbability;
+}
+
+void AlienArmy::clear()
 {
     // Delete all units in the army
     Unit* unit = nullptr;
@@ -178,4 +180,80 @@ AlienArmy::~AlienArmy()
         delete unit;
         unit = nullptr;
     }
+
+    // Start toggling the drones from the front again
+    dronesAddingToggler = false;
+    dronesRemovingToggler = false;
+    dronesPickingToggler = false;
+}
+
+void AlienArmy::saveState(CheckpointWriter& writer)
+{
+    writer.writeInteger(infectingProbability, 4);
+    writer.writeBool(dronesAddingToggler);
+    writer.writeBool(dronesRemovingToggler);
+    writer.writeBool(dronesPickingToggler);
+
+    // Write the soldiers and drones from front to back, each one is enqueued again so the queues end in their order
+    Unit* unit = nullptr;
+    int soldiersCount = soldiers.getCount();
+    writer.writeInteger(soldiersCount, 4);
+    for (int i = 0; i < soldiersCount; i++)
+    {
+        soldiers.dequeue(unit);
+        gamePtr->saveUnit(writer, unit);
+        soldiers.enqueue(unit);
+    }
+
+    int monstersCount = monsters.getCount();
+    writer.writeInteger(monstersCount, 4);
+    for (int i = 0; i < monstersCount; i++)
+    {
+        monsters.entryAt(unit, i);
+        gamePtr->saveUnit(writer, unit);
+    }
+
+    int dronesCount = drones.getCount();
+    writer.writeInteger(dronesCount, 4);
+    for (int i = 0; i < dronesCount; i++)
+    {
+        drones.dequeue(unit);
+        gamePtr->saveUnit(writer, unit);
+        drones.enqueue(unit);
+    }
+}
+
+bool AlienArmy::loadState(CheckpointReader& reader)
+{
+    infectingProbability = (int) reader.readInteger(4);
+    dronesAddingToggler = reader.readBool();
+    dronesRemovingToggler = reader.readBool();
+    dronesPickingToggler = reader.readBool();
+
+    // The units are enqueued directly, adding the drones through addUnit would toggle their side
+    UnitType unitTypes[3] = { UnitType::AS, UnitType::AM, UnitType::AD };
+    for (int i = 0; i < 3; i++)
+    {
+        int unitsCount = (int) reader.readInteger(4);
+        for (int j = 0; j < unitsCount; j++)
+        {
+            Unit* unit = gamePtr->loadUnit(reader, unitTypes[i], UnitLocation::IN_ARMY);
+            if (!unit)
+                return false;
+
+            if (unitTypes[i] == UnitType::AS)
+                soldiers.enqueue(unit);
+            else if (unitTypes[i] == UnitType::AM)
+                monsters.insert(unit);
+            else
+                drones.enqueue(unit);
+        }
+    }
+
+    return true;
+}
+
+AlienArmy::~AlienArmy()
+{
+    clear();
 }
\ No newline at end of file
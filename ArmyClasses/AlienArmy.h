@@ -17,6 +17,8 @@ private:
     Array<Unit*> monsters;
     Deque<Unit*> drones;
 
+    int infectingProbability; // The probability of the monsters infecting the earth soldiers they attack
+
     bool dronesAddingToggler; // Used for peeking the drones in the addUnit function (front or back)
     bool dronesRemovingToggler; // Used for peeking the drones in the removeUnit function (front or back)
     bool dronesPickingToggler; // Used for peeking the drones in the pickAttacker function (front or back)
@@ -30,13 +32,21 @@ public:
     void addUnit(Unit*); // Add a unit to the army
     Unit* removeUnit(UnitType); // Remove a unit from the army and return it
 
-    bool attack(); // Attack the enemy army
+    int pickAttackers(Unit*[]); // Pick the attackers of the current timestep, returns their count
     bool isDead() const; // Check if the army is dead
 
+    void clear(); // Delete all the units in the army and start over empty
+
+    void saveState(CheckpointWriter&); // Write the army's state and its units in their lists' order
+    bool loadState(CheckpointReader&); // Refill the empty army from a checkpoint, returns false if the checkpoint is invalid
+
     void printArmy() const; // Print the army units
 
+    void setInfectingProbability(int); // Set the monsters' infecting probability
+
     // Getters
     int getUnitsCount(UnitType) const; // Get the count of a specific unit type
+    int getInfectingProbability() const;
 
     ~AlienArmy();
 };
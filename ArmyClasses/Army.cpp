@@ -2,4 +2,35 @@
 #include "../Game.h"
 
 Army::Army(Game* gamePtr): gamePtr(gamePtr)
+{}
+
+bool Army::attack()
+{
+    Unit* attackers[MAX_ATTACKERS];
+    int attackersCount = pickAttackers(attackers);
+
+    return attackWith(attackers, attackersCount);
+}
+
+bool Army::attackWith(Unit* attackers[], int attackersCount)
+{
+    // Flag to check if the army attacked
+    bool didArmyAttack = false;
+
+    for (int i = 0; i < attackersCount; i++)
+    {
+        // Attack the enemy
+        bool didUnitAttack = attackers[i]->attack();
+
+        if (didUnitAttack)
+            onUnitAttacked(attackers[i]);
+
+        // If any unit attacked, the army attacked
+        didArmyAttack = didArmyAttack || didUnitAttack;
+    }
+
+    return didArmyAttack; // Return whether the army attacked
+}
+
+void Army::onUnitAttacked(Unit*)
 {}
\ No newline at end of file
@@ -2,6 +2,7 @@
 #define ARMY_H
 
 #include "../UnitClasses/Unit.h"
+#include "../Checkpoint/Checkpoint.h"
 
 class Game;
 
@@ -9,19 +10,27 @@ class Army
 {
 protected:
     Game* gamePtr;
-    LinkedQueue<Unit*> currentAttackers; // The units that are currently attacking the enemy army (used for printing)
 
 private:
     virtual Unit* pickAttacker(UnitType) = 0; // Pick an attacker from the army and return it
+    virtual void onUnitAttacked(Unit*); // Called after one of the army's units attacked successfully
+    bool attackWith(Unit*[], int); // Make the picked attackers attack the enemy army
 
 public:
+    enum { MAX_ATTACKERS = 4 }; // An army picks at most four attackers each timestep
+
     Army(Game*);
 
     virtual void addUnit(Unit*) = 0; // Add a unit to the army
     virtual Unit* removeUnit(UnitType) = 0; // Remove a unit from the army and return it
 
-    virtual bool attack() = 0; // Attack the enemy army
+    bool attack(); // Pick the army's attackers and make them attack the enemy army
+    virtual int pickAttackers(Unit*[]) = 0; // Pick the attackers of the current timestep, returns their count
     virtual bool isDead() const = 0; // Check if the army is dead
+    virtual void clear() = 0; // Delete all the units in the army and start over empty
+
+    virtual void saveState(CheckpointWriter&) = 0; // Write the army's state and its units in their lists' order (the lists end as they started)
+    virtual bool loadState(CheckpointReader&) = 0; // Refill the empty army from a checkpoint, returns false if the checkpoint is invalid
 
     virtual void printArmy() const = 0; // Print the army units
 
@@ -47,28 +47,17 @@ Unit* EarthAlliedArmy::pickAttacker(UnitType unitType)
 	return unit;
 }
 
-bool EarthAlliedArmy::attack()
+int EarthAlliedArmy::pickAttackers(Unit* attackers[])
 {
-	// Flag to check if the army attacked
-	bool didArmyAttack = false;
+	int attackersCount = 0;
 
 	// Pick an attacker from the army to attack
 	Unit* attacker = pickAttacker(UnitType::SU);
 
 	if (attacker)
-	{
-		// Attack the enemy
-		bool didUnitAttack = attacker->attack();
-
-		// Add the attacker to the current attackers queue
-		if (didUnitAttack)
-			currentAttackers.enqueue(attacker);
+		attackers[attackersCount++] = attacker;
 
-		// If any unit attacked, the army attacked
-		didArmyAttack = didArmyAttack || didUnitAttack;
-	}
-
-	return didArmyAttack; // Return whether the army attacked
+	return attackersCount;
 }
 
 bool EarthAlliedArmy::isDead() const
@@ -94,7 +83,7 @@ int EarthAlliedArmy::getUnitsCount(UnitType unitType) const
 	return 0;
 }
 
-EarthAlliedArmy::~EarthAlliedArmy()
+void EarthAlliedArmy::clear()
 {
 	// Delete all units in the army
 	Unit* unit = nullptr;
@@ -105,3 +94,36 @@ EarthAlliedArmy::~EarthAlliedArmy()
 	}
 }
 
+void EarthAlliedArmy::saveState(CheckpointWriter& writer)
+{
+	// Write the savers from front to back, each one is enqueued again so the queue ends in its order
+	Unit* unit = nullptr;
+	int saversCount = savers.getCount();
+	writer.writeInteger(saversCount, 4);
+	for (int i = 0; i < saversCount; i++)
+	{
+		savers.dequeue(unit);
+		gamePtr->saveUnit(writer, unit);
+		savers.enqueue(unit);
+	}
+}
+
+bool EarthAlliedArmy::loadState(CheckpointReader& reader)
+{
+	int saversCount = (int) reader.readInteger(4);
+	for (int i = 0; i < saversCount; i++)
+	{
+		Unit* saver = gamePtr->loadUnit(reader, UnitType::SU, UnitLocation::IN_ARMY);
+		if (!saver)
+			return false;
+
+		savers.enqueue(saver);
+	}
+
+	return true;
+}
+
+EarthAlliedArmy::~EarthAlliedArmy()
+{
+	clear();
+}
\ No newline at end of file
@@ -20,9 +20,14 @@ public:
 	void addUnit(Unit*); // Add a unit to the army
 	Unit* removeUnit(UnitType); // Remove a unit from the army and return it
 
-	bool attack(); // Attack the enemy army
+	int pickAttackers(Unit*[]); // Pick the attackers of the current timestep, returns their count
 	bool isDead() const; // Check if the army is dead
 
+	void clear(); // Delete all the units in the army and start over empty
+
+	void saveState(CheckpointWriter&); // Write the savers in their queue's order
+	bool loadState(CheckpointReader&); // Refill the empty army from a checkpoint, returns false if the checkpoint is invalid
+
 	void printArmy() const; // Print the army units
 
 	// Getters
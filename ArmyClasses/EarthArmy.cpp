@@ -4,9 +4,7 @@
 #include "../UnitClasses/Unit.h"
 #include "../Game.h"
 
-int EarthArmy::infectionThreshold = 0;
-
-EarthArmy::EarthArmy(Game* gamePtr): Army(gamePtr), infectedSoldiersCount(0)
+EarthArmy::EarthArmy(Game* gamePtr): Army(gamePtr), infectionThreshold(0), areTanksAttackingSoldiers(false), infectedSoldiersCount(0)
 {}
 
 void EarthArmy::setInfectionThreshold(int threshold)
@@ -96,10 +94,9 @@ Unit* EarthArmy::pickAttacker(UnitType unitType)
     return unit;
 }
 
-bool EarthArmy::attack()
+int EarthArmy::pickAttackers(Unit* attackers[])
 {
-    // Flag to check if the army attacked
-    bool didArmyAttack = false;
+    int attackersCount = 0;
 
     UnitType unitTypes[4] = { UnitType::ES, UnitType::EG, UnitType::ET, UnitType::EH };
     for (int i = 0; i < 4; i++)
@@ -108,24 +105,17 @@ bool EarthArmy::attack()
         Unit* attacker = pickAttacker(unitTypes[i]);
 
         if (attacker)
-        {
-            // Attack the enemy
-            bool didUnitAttack = attacker->attack();
-
-            // Healers need to be killed once they attack
-            if (attacker->getUnitType() == UnitType::EH && didUnitAttack)
-                killHealUnit();
-
-            // Add the attacker to the current attackers queue
-            if (didUnitAttack)
-                currentAttackers.enqueue(attacker);
-
-            // If any unit attacked, the army attacked
-            didArmyAttack = didArmyAttack || didUnitAttack;
-        }
+            attackers[attackersCount++] = attacker;
     }
 
-    return didArmyAttack; // Return whether the army attacked
+    return attackersCount;
+}
+
+void EarthArmy::onUnitAttacked(Unit* attacker)
+{
+    // Healers need to be killed once they attack
+    if (attacker->getUnitType() == UnitType::EH)
+        killHealUnit();
 }
 
 bool EarthArmy::isDead() const
@@ -138,6 +128,19 @@ bool EarthArmy::needAllyHelp() const
     return getInfectionPercentage() >= infectionThreshold;
 }
 
+bool EarthArmy::willTanksAttackSoldiers()
+{
+    int alienSoldiersCount = gamePtr->getUnitsCount(ALIEN, AS);
+    float soldiersRatio = alienSoldiersCount > 0 ? (float) soldiers.getCount() / alienSoldiersCount : -1;
+
+    if (soldiersRatio < 0.3 && soldiersRatio >= 0) // Attacks soldiers if the soldiers ration is below 30%
+        areTanksAttackingSoldiers = true;
+    else if (soldiersRatio > 0.8) // Until it exceeds 80%
+        areTanksAttackingSoldiers = false;
+
+    return areTanksAttackingSoldiers;
+}
+
 void EarthArmy::printArmy() const
 {
     std::cout << "Infected percentage = " << getInfectionPercentage() << "%" << std::endl;
@@ -176,36 +179,24 @@ void EarthArmy::killHealUnit()
 void EarthArmy::spreadInfection()
 {
     int soldiersCount = soldiers.getCount();
-    int soldiersToInfect = infectedSoldiersCount;
 
     // if there are no soldiers to infect, return
     if (soldiersCount == 0)
         return;
 
-    // Infect random soldiers
-    for (int i = 0; i < soldiersToInfect; i++)
-    {
-        // Generate random number and decide to infect or not accordingly
-        int x = rand() % 100 + 1;
-        if (x > INFECTION_SPREAD_CHANCE)
-            continue;
+    // Each infected soldier spreads the infection with a small chance, so only the successful attempts are sampled
+    int attemptsCount = gamePtr->getBinomialNumber(infectedSoldiersCount, INFECTION_SPREAD_CHANCE);
 
-        // Get a random index to infect
-        int randomIndex = rand() % soldiersCount;
+    // Infect the soldier at a random index of the queue in place
+    Unit* soldier = nullptr;
+    for (int i = 0; i < attemptsCount; i++)
+    {
+        soldiers.entryAt(soldier, gamePtr->getRandomNumber(0, soldiersCount - 1));
 
-        // Infect the soldier at the random index and re-enqueue the soldiers
-        Unit* soldier = nullptr;
-        for (int j = 0; j < soldiersCount; j++)
+        if (dynamic_cast<EarthSoldier*>(soldier)->getInfection())
         {
-            soldiers.dequeue(soldier);
-
-            if (j == randomIndex)
-            {
-                if (dynamic_cast<EarthSoldier*>(soldier)->getInfection())
-                    infectedSoldiersCount++;
-            }
-
-            soldiers.enqueue(soldier);
+            infectedSoldiersCount++;
+            gamePtr->rehashUnit(soldier);
         }
     }
 }
@@ -243,7 +234,7 @@ int EarthArmy::getInfectedSoldiersCount() const
     return infectedSoldiersCount;
 }
 
-EarthArmy::~EarthArmy()
+void EarthArmy::clear()
 {
     // Delete all units in the army
     Unit* unit = nullptr;
@@ -272,4 +263,109 @@ EarthArmy::~EarthArmy()
         delete unit;
         unit = nullptr;
     }
+
+    infectedSoldiersCount = 0;
+    areTanksAttackingSoldiers = false;
+}
+
+void EarthArmy::saveState(CheckpointWriter& writer)
+{
+    writer.writeInteger(infectionThreshold, 4);
+    writer.writeBool(areTanksAttackingSoldiers);
+
+    // Write the soldiers from front to back, each one is enqueued again so the queue ends in its order
+    Unit* unit = nullptr;
+    int soldiersCount = soldiers.getCount();
+    writer.writeInteger(soldiersCount, 4);
+    for (int i = 0; i < soldiersCount; i++)
+    {
+        soldiers.dequeue(unit);
+        gamePtr->saveUnit(writer, unit);
+        soldiers.enqueue(unit);
+    }
+
+    saveStack(writer, tanks);
+
+    // Move the gunneries to a second queue with their priorities (equal priorities keep their order), then write them while moving them back
+    PriorityQueue<Unit*> savedGunneries;
+    int priority = 0;
+    while (gunneries.dequeue(unit, priority))
+        savedGunneries.enqueue(unit, priority);
+
+    writer.writeInteger(savedGunneries.getCount(), 4);
+    while (savedGunneries.dequeue(unit, priority))
+    {
+        gamePtr->saveUnit(writer, unit);
+        writer.writeInteger(priority, 4);
+        gunneries.enqueue(unit, priority);
+    }
+
+    saveStack(writer, healers);
+}
+
+bool EarthArmy::loadState(CheckpointReader& reader)
+{
+    infectionThreshold = (int) reader.readInteger(4);
+    areTanksAttackingSoldiers = reader.readBool();
+
+    int soldiersCount = (int) reader.readInteger(4);
+    for (int i = 0; i < soldiersCount; i++)
+    {
+        Unit* soldier = gamePtr->loadUnit(reader, UnitType::ES, UnitLocation::IN_ARMY);
+        if (!soldier)
+            return false;
+
+        addUnit(soldier); // Counts the infected soldiers
+    }
+
+    if (!loadStack(reader, tanks, UnitType::ET))
+        return false;
+
+    int gunneriesCount = (int) reader.readInteger(4);
+    for (int i = 0; i < gunneriesCount; i++)
+    {
+        Unit* gunnery = gamePtr->loadUnit(reader, UnitType::EG, UnitLocation::IN_ARMY);
+        if (!gunnery)
+            return false;
+
+        gunneries.enqueue(gunnery, (int) reader.readInteger(4)); // The priority it was enqueued with
+    }
+
+    return loadStack(reader, healers, UnitType::EH);
+}
+
+void EarthArmy::saveStack(CheckpointWriter& writer, ArrayStack<Unit*>& stack)
+{
+    // Reverse the stack, then write the units while pushing them back
+    ArrayStack<Unit*> reversedStack;
+    Unit* unit = nullptr;
+    while (stack.pop(unit))
+        reversedStack.push(unit);
+
+    writer.writeInteger(reversedStack.getCount(), 4);
+    while (reversedStack.pop(unit))
+    {
+        gamePtr->saveUnit(writer, unit);
+        stack.push(unit);
+    }
+}
+
+bool EarthArmy::loadStack(CheckpointReader& reader, ArrayStack<Unit*>& stack, UnitType unitType)
+{
+    int unitsCount = (int) reader.readInteger(4);
+    for (int i = 0; i < unitsCount; i++)
+    {
+        Unit* unit = gamePtr->loadUnit(reader, unitType, UnitLocation::IN_ARMY);
+        if (!unit)
+            return false;
+
+        stack.push(unit);
+    }
+
+    return true;
+}
+
+EarthArmy::~EarthArmy()
+{
+    clear();
 }
\ No newline at end of file
@@ -3,7 +3,7 @@
 
 #include "Army.h"
 #include "..\Containers\ArrayStack.h"
-#include "..\Containers\LinkedQueue.h"
+#include "..\Containers\DynamicQueue.h"
 #include "..\Containers\PriorityQueue.h"
 #include "..\UnitClasses\Unit.h"
 #include "..\UnitClasses\EarthSoldier.h"
@@ -15,9 +15,10 @@ class EarthArmy: public Army
 {
 private:
     enum { INFECTION_SPREAD_CHANCE = 2 }; // Chance to spread infection
-    static int infectionThreshold; // Infection threshold for the army to need ally help
+    int infectionThreshold; // Infection threshold for the army to need ally help
+    bool areTanksAttackingSoldiers; // If the tanks are attacking soldiers in the current timestep
 
-    LinkedQueue<Unit*> soldiers;
+    DynamicQueue<Unit*> soldiers; // Any soldier can be reached by its position to be infected
     ArrayStack<Unit*> tanks;
     PriorityQueue<Unit*> gunneries;
     ArrayStack<Unit*> healers;
@@ -26,19 +27,27 @@ private:
 
 private:
     Unit* pickAttacker(UnitType); // Pick an attacker from the army and return it
+    void onUnitAttacked(Unit*); // Kill the healers once they heal
+    void saveStack(CheckpointWriter&, ArrayStack<Unit*>&); // Write the stack's units from bottom to top
+    bool loadStack(CheckpointReader&, ArrayStack<Unit*>&, UnitType); // Push the units written by saveStack
 
 public:
     EarthArmy(Game*);
 
-    // Static functions
-    static void setInfectionThreshold(int); // Set the infection threshold for the army
+    void setInfectionThreshold(int); // Set the infection threshold for the army
 
     void addUnit(Unit*); // Add a unit to the army
     Unit* removeUnit(UnitType); // Remove a unit from the army and return it
 
-    bool attack(); // Attack the enemy army
+    int pickAttackers(Unit*[]); // Pick the attackers of the current timestep, returns their count
     bool isDead() const; // Check if the army is dead
     bool needAllyHelp() const; // Check if the army needs ally help
+    bool willTanksAttackSoldiers(); // Check if the tanks will attack alien soldiers in the current timestep
+
+    void clear(); // Delete all the units in the army and start over empty
+
+    void saveState(CheckpointWriter&); // Write the army's state and its units in their lists' order
+    bool loadState(CheckpointReader&); // Refill the empty army from a checkpoint, returns false if the checkpoint is invalid
 
     void printArmy() const; // Print the army units
 
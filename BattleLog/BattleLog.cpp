@@ -0,0 +1,389 @@
+#include "BattleLog.h"
+
+// Helper functions of the encoding
+unsigned long long encodeZigzag(long long value) // Helper function to map signed numbers to unsigned ones with small magnitudes first (0, -1, 1, -2, ...)
+{
+	return ((unsigned long long) value << 1) ^ (unsigned long long) (value >> 63);
+}
+
+long long decodeZigzag(unsigned long long value) // Helper function to reverse encodeZigzag
+{
+	return (long long) (value >> 1) ^ -(long long) (value & 1);
+}
+
+void clearBattleLogTimestep(BattleLogTimestep& timestep)
+{
+	timestep.reinforcements.clear();
+	timestep.attackers.clear();
+	timestep.targets.clear();
+	timestep.deaths.clear();
+}
+
+BattleLogWriter::BattleLogWriter(): lastTimestep(0)
+{}
+
+void BattleLogWriter::writeByte(int byte)
+{
+	buffer.push_back((char) byte);
+}
+
+void BattleLogWriter::writeVarint(unsigned long long value)
+{
+	while (value >= 0x80)
+	{
+		writeByte((int) (value & 0x7F) | 0x80);
+		value >>= 7;
+	}
+
+	writeByte((int) value);
+}
+
+void BattleLogWriter::writeSignedVarint(long long value)
+{
+	writeVarint(encodeZigzag(value));
+}
+
+void BattleLogWriter::flushBuffer()
+{
+	file.write(buffer.data(), buffer.size());
+	buffer.clear();
+}
+
+bool BattleLogWriter::open(const std::string& fileName)
+{
+	file.open(fileName, std::ios::binary | std::ios::trunc);
+	if (!file.is_open())
+		return false;
+
+	lastTimestep = 0;
+	buffer.clear();
+	buffer.reserve(CHUNK_SIZE * 2);
+
+	// The magic number is written low byte first like every other number
+	for (int i = 0; i < 4; i++)
+		writeByte((BATTLE_LOG_MAGIC >> (8 * i)) & 0xFF);
+	writeVarint(BATTLE_LOG_VERSION);
+
+	return true;
+}
+
+bool BattleLogWriter::isOpen() const
+{
+	return file.is_open();
+}
+
+void BattleLogWriter::writeTimestep(const BattleLogTimestep& timestep)
+{
+	writeByte(BattleLogBlock::TIMESTEP_BLOCK);
+	writeVarint(timestep.timestep - lastTimestep);
+	lastTimestep = timestep.timestep;
+
+	// Reinforcements, each army numbers its units consecutively so most IDs are one more than the previous
+	LoggedUnit unit = { 0 };
+	int previousId = 0;
+	writeVarint(timestep.reinforcements.getCount());
+	for (int i = 0; i < timestep.reinforcements.getCount(); i++)
+	{
+		timestep.reinforcements.entryAt(unit, i);
+		writeVarint(encodeZigzag(unit.id - previousId - 1) << 3 | unit.unitType);
+		previousId = unit.id;
+	}
+
+	// Attackers with their targets count of each action
+	LoggedAttacker attacker = { 0 };
+	previousId = 0;
+	writeVarint(timestep.attackers.getCount());
+	for (int i = 0; i < timestep.attackers.getCount(); i++)
+	{
+		timestep.attackers.entryAt(attacker, i);
+		writeVarint(encodeZigzag(attacker.id - previousId) << 4 | attacker.unitType << 1 | (attacker.isInfected ? 1 : 0));
+		previousId = attacker.id;
+
+		for (int action = 0; action < AttackAction::ATTACK_ACTION_TOTAL; action++)
+			writeVarint(attacker.targetsCounts[action]);
+	}
+
+	// Targets grouped by action, so the shot units, the healed units and the infected soldiers are each delta-encoded in their own run
+	short targetId = 0;
+	for (int action = 0; action < AttackAction::ATTACK_ACTION_TOTAL; action++)
+	{
+		int firstTargetIndex = 0;
+		previousId = 0;
+
+		for (int i = 0; i < timestep.attackers.getCount(); i++)
+		{
+			timestep.attackers.entryAt(attacker, i);
+
+			int actionTargetIndex = firstTargetIndex;
+			for (int previousAction = 0; previousAction < action; previousAction++)
+				actionTargetIndex += attacker.targetsCounts[previousAction];
+
+			for (int j = 0; j < attacker.targetsCounts[action]; j++)
+			{
+				timestep.targets.entryAt(targetId, actionTargetIndex + j);
+				writeSignedVarint(targetId - previousId);
+				previousId = targetId;
+			}
+
+			for (int previousAction = 0; previousAction < AttackAction::ATTACK_ACTION_TOTAL; previousAction++)
+				firstTargetIndex += attacker.targetsCounts[previousAction];
+		}
+	}
+
+	// Deaths, their destruction time is the block's timestep and the other times are stored relative to it
+	KilledUnitRecord record = { 0 };
+	previousId = 0;
+	writeVarint(timestep.deaths.getCount());
+	for (int i = 0; i < timestep.deaths.getCount(); i++)
+	{
+		timestep.deaths.entryAt(record, i);
+		writeSignedVarint(record.id - previousId);
+		writeVarint(record.flags | record.unitType << 3);
+		writeVarint(timestep.timestep - record.Tj);
+		writeVarint(record.Ta == -1 ? 0 : record.Ta - record.Tj + 1);
+		previousId = record.id;
+	}
+
+	if (buffer.size() >= CHUNK_SIZE)
+		flushBuffer();
+}
+
+bool BattleLogWriter::close(const BattleLogSummary& summary)
+{
+	writeByte(BattleLogBlock::SUMMARY_BLOCK);
+
+	writeVarint(summary.battleResult.size());
+	buffer.append(summary.battleResult);
+	writeVarint(summary.totalTimesteps);
+
+	const GameStatistics& statistics = summary.statistics;
+	for (int i = 0; i < UnitType::UNIT_TOTAL; i++)
+	{
+		writeVarint(statistics.unitCounts[i]);
+		writeVarint(statistics.destructedUnitCounts[i]);
+	}
+
+	writeVarint(statistics.totalHealedUnits);
+	writeVarint(statistics.totalInfectedESCount);
+	writeVarint(statistics.totalUnitsCount);
+	writeVarint(statistics.totalDestructedUnitsCount);
+
+	// The delays' totals can be negative (Df is -1 for a unit never attacked)
+	for (int i = 0; i < ArmyType::ARMY_TOTAL; i++)
+	{
+		const ArmyStatistics& armyStatistics = statistics.armyStatistics[i];
+
+		writeVarint(armyStatistics.totalUnitsCount);
+		writeVarint(armyStatistics.totalDestructedUnitsCount);
+		writeSignedVarint(armyStatistics.totalFirstAttackDelays);
+		writeSignedVarint(armyStatistics.totalBattleDelays);
+		writeSignedVarint(armyStatistics.totalDestructionDelays);
+	}
+
+	flushBuffer();
+
+	bool isWritten = file.good();
+	file.close();
+
+	return isWritten;
+}
+
+BattleLogReader::BattleLogReader(): hasFailed(false), lastTimestep(0)
+{}
+
+int BattleLogReader::readByte()
+{
+	int byte = file.get();
+	if (byte == std::ifstream::traits_type::eof())
+	{
+		hasFailed = true;
+		return 0;
+	}
+
+	return byte;
+}
+
+unsigned long long BattleLogReader::readVarint()
+{
+	unsigned long long value = 0;
+
+	for (int shift = 0; shift < 64 && !hasFailed; shift += 7)
+	{
+		int byte = readByte();
+		value |= (unsigned long long) (byte & 0x7F) << shift;
+
+		if (!(byte & 0x80))
+			return value;
+	}
+
+	// Too long to be a number written by the writer
+	hasFailed = true;
+	return 0;
+}
+
+long long BattleLogReader::readSignedVarint()
+{
+	return decodeZigzag(readVarint());
+}
+
+bool BattleLogReader::open(const std::string& fileName)
+{
+	file.open(fileName, std::ios::binary);
+	hasFailed = !file.is_open();
+	lastTimestep = 0;
+
+	unsigned magic = 0;
+	for (int i = 0; i < 4 && !hasFailed; i++)
+		magic |= (unsigned) readByte() << (8 * i);
+
+	if (magic != BATTLE_LOG_MAGIC || readVarint() != BATTLE_LOG_VERSION)
+		hasFailed = true;
+
+	return !hasFailed;
+}
+
+bool BattleLogReader::readTimestep(BattleLogTimestep& timestep)
+{
+	clearBattleLogTimestep(timestep);
+
+	if (hasFailed)
+		return false;
+
+	int tag = readByte();
+	if (tag != BattleLogBlock::TIMESTEP_BLOCK)
+	{
+		// Only the summary may follow the last timestep
+		if (tag != BattleLogBlock::SUMMARY_BLOCK)
+			hasFailed = true;
+
+		return false;
+	}
+
+	lastTimestep += (int) readVarint();
+	timestep.timestep = lastTimestep;
+
+	// Reinforcements
+	int previousId = 0;
+	int count = (int) readVarint();
+	for (int i = 0; i < count && !hasFailed; i++)
+	{
+		unsigned long long value = readVarint();
+		LoggedUnit unit = { (short) (previousId + 1 + decodeZigzag(value >> 3)), (UnitType) (value & 0x7) };
+		timestep.reinforcements.insert(unit);
+		previousId = unit.id;
+	}
+
+	// Attackers
+	int targetsCount = 0;
+	previousId = 0;
+	count = (int) readVarint();
+	for (int i = 0; i < count && !hasFailed; i++)
+	{
+		unsigned long long value = readVarint();
+		LoggedAttacker attacker = { (short) (previousId + decodeZigzag(value >> 4)), (UnitType) ((value >> 1) & 0x7), (value & 1) != 0 };
+
+		for (int action = 0; action < AttackAction::ATTACK_ACTION_TOTAL; action++)
+		{
+			attacker.targetsCounts[action] = (int) readVarint();
+			targetsCount += attacker.targetsCounts[action];
+		}
+
+		timestep.attackers.insert(attacker);
+		previousId = attacker.id;
+	}
+
+	// Targets, read by action and placed back after their attacker's targets of the previous actions
+	for (int i = 0; i < targetsCount && !hasFailed; i++)
+		timestep.targets.insert(0);
+
+	LoggedAttacker attacker = { 0 };
+	for (int action = 0; action < AttackAction::ATTACK_ACTION_TOTAL; action++)
+	{
+		int firstTargetIndex = 0;
+		previousId = 0;
+
+		for (int i = 0; i < timestep.attackers.getCount() && !hasFailed; i++)
+		{
+			timestep.attackers.entryAt(attacker, i);
+
+			int actionTargetIndex = firstTargetIndex;
+			for (int previousAction = 0; previousAction < action; previousAction++)
+				actionTargetIndex += attacker.targetsCounts[previousAction];
+
+			for (int j = 0; j < attacker.targetsCounts[action] && !hasFailed; j++)
+			{
+				previousId += (int) readSignedVarint();
+				timestep.targets.replace(actionTargetIndex + j, (short) previousId);
+			}
+
+			for (int previousAction = 0; previousAction < AttackAction::ATTACK_ACTION_TOTAL; previousAction++)
+				firstTargetIndex += attacker.targetsCounts[previousAction];
+		}
+	}
+
+	// Deaths
+	previousId = 0;
+	count = (int) readVarint();
+	for (int i = 0; i < count && !hasFailed; i++)
+	{
+		KilledUnitRecord record = { timestep.timestep };
+		record.id = (short) (previousId + readSignedVarint());
+
+		unsigned long long value = readVarint();
+		record.flags = (unsigned char) (value & 0x7);
+		record.unitType = (UnitType) (value >> 3);
+
+		record.Tj = timestep.timestep - (int) readVarint();
+		int firstAttackOffset = (int) readVarint();
+		record.Ta = firstAttackOffset == 0 ? -1 : record.Tj + firstAttackOffset - 1;
+
+		if (record.unitType >= UnitType::UNIT_TOTAL)
+			hasFailed = true;
+
+		timestep.deaths.insert(record);
+		previousId = record.id;
+	}
+
+	return !hasFailed;
+}
+
+bool BattleLogReader::readSummary(BattleLogSummary& summary)
+{
+	// readTimestep consumed the summary's tag when it stopped
+	int resultLength = (int) readVarint();
+	summary.battleResult.clear();
+	for (int i = 0; i < resultLength && !hasFailed; i++)
+		summary.battleResult.push_back((char) readByte());
+
+	summary.totalTimesteps = (int) readVarint();
+
+	GameStatistics& statistics = summary.statistics;
+	for (int i = 0; i < UnitType::UNIT_TOTAL; i++)
+	{
+		statistics.unitCounts[i] = (int) readVarint();
+		statistics.destructedUnitCounts[i] = (int) readVarint();
+	}
+
+	statistics.totalHealedUnits = (int) readVarint();
+	statistics.totalInfectedESCount = (int) readVarint();
+	statistics.totalUnitsCount = (int) readVarint();
+	statistics.totalDestructedUnitsCount = (int) readVarint();
+
+	for (int i = 0; i < ArmyType::ARMY_TOTAL; i++)
+	{
+		ArmyStatistics& armyStatistics = statistics.armyStatistics[i];
+
+		armyStatistics.totalUnitsCount = (int) readVarint();
+		armyStatistics.totalDestructedUnitsCount = (int) readVarint();
+		armyStatistics.totalFirstAttackDelays = (int) readSignedVarint();
+		armyStatistics.totalBattleDelays = (int) readSignedVarint();
+		armyStatistics.totalDestructionDelays = (int) readSignedVarint();
+	}
+
+	return !hasFailed;
+}
+
+bool BattleLogReader::isValid() const
+{
+	return !hasFailed;
+}
\ No newline at end of file
@@ -0,0 +1,101 @@
+#ifndef BATTLE_LOG_H
+#define BATTLE_LOG_H
+
+#include <fstream>
+#include <string>
+
+#include "../DEFS.h"
+#include "../Containers/DynamicArray.h"
+
+// A battle log is a compact binary record of every played timestep's reinforcements, attacks and deaths followed by the battle's results
+// IDs are delta-encoded and every number is a varint, so a timestep takes about a byte per unit involved
+enum BattleLogFormat
+{
+	BATTLE_LOG_MAGIC = 0x4C424941, // "AIBL"
+	BATTLE_LOG_VERSION = 1,
+};
+
+enum BattleLogBlock
+{
+	TIMESTEP_BLOCK = 'T',
+	SUMMARY_BLOCK = 'E', // The battle's results, the last block of the log
+};
+
+struct LoggedUnit // A unit generated in the timestep
+{
+	short id;
+	UnitType unitType;
+};
+
+struct LoggedAttacker // An attacker of the timestep, its targets follow the previous attacker's targets
+{
+	short id;
+	UnitType unitType;
+	bool isInfected; // The attacker's infection at the end of the timestep
+	int targetsCounts[AttackAction::ATTACK_ACTION_TOTAL]; // Its targets are grouped by action in the actions' order
+};
+
+struct BattleLogTimestep // Everything that happened in a timestep
+{
+	int timestep;
+	DynamicArray<LoggedUnit> reinforcements;
+	DynamicArray<LoggedAttacker> attackers; // In the order they attacked
+	DynamicArray<short> targets; // IDs of the attackers' targets
+	DynamicArray<KilledUnitRecord> deaths; // In destruction order
+};
+
+struct BattleLogSummary // Results of the battle
+{
+	std::string battleResult;
+	int totalTimesteps;
+	GameStatistics statistics;
+};
+
+void clearBattleLogTimestep(BattleLogTimestep&); // Empty the timestep's lists while keeping their storage
+
+// Encodes the timesteps in memory and writes them to the file in large chunks
+class BattleLogWriter
+{
+private:
+	enum { CHUNK_SIZE = 1 << 16 }; // Bytes buffered before writing them to the file
+	std::ofstream file;
+	std::string buffer; // Encoded bytes not written yet
+	int lastTimestep; // Timesteps are stored as the difference from the previous one
+
+private:
+	void writeByte(int);
+	void writeVarint(unsigned long long); // Seven bits per byte, the high bit marks that more bytes follow
+	void writeSignedVarint(long long); // Zigzag-encoded, so small negative numbers take a byte too
+	void flushBuffer(); // Write the buffered bytes to the file
+
+public:
+	BattleLogWriter();
+
+	bool open(const std::string&); // Create the file and write the header
+	bool isOpen() const;
+	void writeTimestep(const BattleLogTimestep&); // Append a played timestep
+	bool close(const BattleLogSummary&); // Write the summary and close the file, returns false if any write failed
+};
+
+class BattleLogReader
+{
+private:
+	std::ifstream file;
+	bool hasFailed; // Set once the file is missing, short or malformed
+	int lastTimestep;
+
+private:
+	int readByte();
+	unsigned long long readVarint();
+	long long readSignedVarint();
+
+public:
+	BattleLogReader();
+
+	bool open(const std::string&); // Open the file and check its header
+	bool readTimestep(BattleLogTimestep&); // Read the next timestep, returns false once the summary is reached
+	bool readSummary(BattleLogSummary&); // Read the summary after the last timestep
+	bool isValid() const; // Check if every read so far succeeded
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,16 @@
+#ifndef BATTLE_OBSERVER_H
+#define BATTLE_OBSERVER_H
+
+#include "BattleLog.h"
+
+// Receives the battle's events in the batches the battle log is written from, one call per timestep rather than one per attack
+// Registered with Game::addObserver, the game doesn't own its observers
+class BattleObserver
+{
+public:
+	virtual void onTimestep(const BattleLogTimestep&) = 0; // The reinforcements, shots, heals, infections and deaths of a played timestep
+	virtual void onBattleEnd(const BattleLogSummary&) {} // The result and statistics of the finished battle
+	virtual ~BattleObserver() {}
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,121 @@
+#include <cstring>
+
+#include "Checkpoint.h"
+
+int getCheckpointBuildFlags()
+{
+	int buildFlags = 0;
+
+#ifdef FIXED_POINT_HEALTH
+	buildFlags |= 1; // Health is saved as a fixed-point integer instead of a double
+#endif
+#ifdef OUTCOME_ONLY
+	buildFlags |= 2; // No lifecycle times nor killed list are saved
+#endif
+
+	return buildFlags;
+}
+
+CheckpointWriter::CheckpointWriter(std::ostream& stream): stream(stream)
+{}
+
+void CheckpointWriter::writeHeader(unsigned int magic, int version)
+{
+	writeInteger(magic, 4);
+	writeInteger(version, 2);
+	writeInteger(getCheckpointBuildFlags(), 1);
+}
+
+void CheckpointWriter::writeInteger(unsigned long long value, int bytesCount)
+{
+	char bytes[8];
+
+	for (int i = 0; i < bytesCount; i++)
+		bytes[i] = (char) (value >> (8 * i) & 0xFF);
+
+	stream.write(bytes, bytesCount);
+}
+
+void CheckpointWriter::writeBool(bool value)
+{
+	writeInteger(value ? 1 : 0, 1);
+}
+
+void CheckpointWriter::writeHealth(HealthValue health)
+{
+#ifdef FIXED_POINT_HEALTH
+	writeInteger((unsigned int) health, 4);
+#else
+	unsigned long long healthBits = 0;
+	std::memcpy(&healthBits, &health, sizeof(health)); // A double has the size of the integer, so the bits keep their order
+
+	writeInteger(healthBits, 8);
+#endif
+}
+
+bool CheckpointWriter::isValid()
+{
+	stream.flush();
+
+	return stream.good();
+}
+
+CheckpointReader::CheckpointReader(std::istream& stream): stream(stream), hasFailed(false)
+{}
+
+bool CheckpointReader::readHeader(unsigned int magic, int version)
+{
+	// Only a file of the same format written by a build with the same options can be read
+	if (readInteger(4) != magic || (int) readInteger(2) != version || (int) readInteger(1) != getCheckpointBuildFlags())
+		fail();
+
+	return isValid();
+}
+
+unsigned long long CheckpointReader::readInteger(int bytesCount)
+{
+	if (hasFailed)
+		return 0;
+
+	unsigned char bytes[8];
+	if (!stream.read((char*) bytes, bytesCount))
+	{
+		fail();
+		return 0;
+	}
+
+	unsigned long long value = 0;
+	for (int i = 0; i < bytesCount; i++)
+		value |= (unsigned long long) bytes[i] << (8 * i);
+
+	return value;
+}
+
+bool CheckpointReader::readBool()
+{
+	return readInteger(1) != 0;
+}
+
+HealthValue CheckpointReader::readHealth()
+{
+#ifdef FIXED_POINT_HEALTH
+	return (HealthValue) (unsigned int) readInteger(4);
+#else
+	unsigned long long healthBits = readInteger(8);
+
+	HealthValue health;
+	std::memcpy(&health, &healthBits, sizeof(health));
+
+	return health;
+#endif
+}
+
+void CheckpointReader::fail()
+{
+	hasFailed = true;
+}
+
+bool CheckpointReader::isValid() const
+{
+	return !hasFailed;
+}
\ No newline at end of file
@@ -0,0 +1,55 @@
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include <iostream>
+
+#include "../UnitClasses/HealthArithmetic.h"
+
+// A checkpoint or replay file starts with its magic, format version and the build flags that change the saved state
+// Every value is written in little-endian order with a fixed width, so files move between machines
+enum CheckpointFormat
+{
+	CHECKPOINT_MAGIC = 0x50434941, // "AICP"
+	CHECKPOINT_VERSION = 1,
+};
+
+// Writes the fields of a checkpoint in order to the stream, the reader reads them back in the same order
+class CheckpointWriter
+{
+private:
+	std::ostream& stream;
+
+public:
+	CheckpointWriter(std::ostream&);
+
+	void writeHeader(unsigned int, int); // Write the file's magic and format version followed by the build flags
+
+	void writeInteger(unsigned long long, int); // Write the low bytes of the value in the given number of bytes
+	void writeBool(bool);
+	void writeHealth(HealthValue); // Write the health's bits, so the resumed battle continues from the exact value
+
+	bool isValid(); // Check if every write so far succeeded (flushes the stream)
+};
+
+class CheckpointReader
+{
+private:
+	std::istream& stream;
+	bool hasFailed; // Set once the stream is short or doesn't match this build
+
+public:
+	CheckpointReader(std::istream&);
+
+	bool readHeader(unsigned int, int); // Check the file's magic, format version and build flags
+
+	unsigned long long readInteger(int); // Read a value written in the given number of bytes
+	bool readBool();
+	HealthValue readHealth();
+
+	void fail(); // Mark the checkpoint as invalid (used for values out of their range)
+	bool isValid() const; // Check if every read so far succeeded
+};
+
+int getCheckpointBuildFlags(); // The build options that change what a checkpoint holds
+
+#endif
\ No newline at end of file
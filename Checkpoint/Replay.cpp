@@ -0,0 +1,124 @@
+#include "Replay.h"
+
+ReplayWriter::ReplayWriter(): writer(file)
+{}
+
+bool ReplayWriter::open(const std::string& fileName)
+{
+	keyframes.clear();
+
+	file.open(fileName, std::ios::binary);
+	writer.writeHeader(ReplayFormat::REPLAY_MAGIC, ReplayFormat::REPLAY_VERSION);
+
+	return writer.isValid();
+}
+
+bool ReplayWriter::isOpen() const
+{
+	return file.is_open();
+}
+
+CheckpointWriter& ReplayWriter::startKeyframe(int timestep)
+{
+	writer.writeInteger(ReplayBlock::KEYFRAME_BLOCK, 1);
+
+	ReplayKeyframe keyframe = { timestep, (unsigned long long) file.tellp() };
+	keyframes.insert(keyframe);
+
+	return writer;
+}
+
+void ReplayWriter::writeStep(const ReplayStep& step)
+{
+	writer.writeInteger(ReplayBlock::STEP_BLOCK, 1);
+	writer.writeInteger(step.timestep, 4);
+	writer.writeBool(step.didArmiesAttack);
+	writer.writeInteger(step.destructedUnitsCount, 4);
+	writer.writeInteger(step.stateHash, 8);
+}
+
+bool ReplayWriter::close()
+{
+	// The index ends with its own offset, so a reader finds it from the end of the file
+	unsigned long long indexOffset = (unsigned long long) file.tellp();
+
+	writer.writeInteger(ReplayBlock::INDEX_BLOCK, 1);
+	writer.writeInteger(keyframes.getCount(), 4);
+
+	ReplayKeyframe keyframe = { 0, 0 };
+	for (int i = 0; keyframes.entryAt(keyframe, i); i++)
+	{
+		writer.writeInteger(keyframe.timestep, 4);
+		writer.writeInteger(keyframe.offset, 8);
+	}
+
+	writer.writeInteger(indexOffset, 8);
+
+	bool isValid = writer.isValid();
+	file.close();
+	file.clear();
+
+	return isValid;
+}
+
+ReplayReader::ReplayReader(): reader(file)
+{}
+
+bool ReplayReader::open(const std::string& fileName)
+{
+	file.open(fileName, std::ios::binary);
+	if (!file.is_open() || !reader.readHeader(ReplayFormat::REPLAY_MAGIC, ReplayFormat::REPLAY_VERSION))
+		return false;
+
+	// Find the index from the offset at the end of the file
+	file.seekg(-8, std::ios::end);
+	file.seekg((std::streamoff) reader.readInteger(8));
+
+	if (reader.readInteger(1) != ReplayBlock::INDEX_BLOCK)
+		reader.fail();
+
+	int keyframesCount = (int) reader.readInteger(4);
+	for (int i = 0; i < keyframesCount && reader.isValid(); i++)
+	{
+		ReplayKeyframe keyframe = { 0, 0 };
+		keyframe.timestep = (int) reader.readInteger(4);
+		keyframe.offset = reader.readInteger(8);
+
+		keyframes.insert(keyframe);
+	}
+
+	return reader.isValid();
+}
+
+CheckpointReader* ReplayReader::seekKeyframe(int timestep)
+{
+	// The keyframes are indexed in timestep order
+	ReplayKeyframe nearestKeyframe = { 0, 0 };
+	bool isFound = false;
+
+	ReplayKeyframe keyframe = { 0, 0 };
+	for (int i = 0; keyframes.entryAt(keyframe, i) && keyframe.timestep <= timestep; i++)
+	{
+		nearestKeyframe = keyframe;
+		isFound = true;
+	}
+
+	if (!isFound)
+		return nullptr;
+
+	file.seekg((std::streamoff) nearestKeyframe.offset);
+	return &reader;
+}
+
+bool ReplayReader::readStep(ReplayStep& step)
+{
+	if (reader.readInteger(1) != ReplayBlock::STEP_BLOCK)
+		return false;
+
+	step.timestep = (int) reader.readInteger(4);
+	step.didArmiesAttack = reader.readBool();
+	step.destructedUnitsCount = (int) reader.readInteger(4);
+	step.stateHash = reader.readInteger(8);
+
+	return reader.isValid();
+}
\ No newline at end of file
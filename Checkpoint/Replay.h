@@ -0,0 +1,73 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include <fstream>
+#include <string>
+
+#include "Checkpoint.h"
+#include "../Containers/DynamicArray.h"
+
+// A replay is a stream of blocks: a keyframe (a full checkpoint) every few timesteps and a record after every played timestep
+// The keyframes' index is written at the end of the file, so a viewer jumps to the nearest keyframe and rolls the battle forward from it
+enum ReplayFormat
+{
+	REPLAY_MAGIC = 0x50524941, // "AIRP"
+	REPLAY_VERSION = 1,
+};
+
+enum ReplayBlock
+{
+	KEYFRAME_BLOCK = 'K',
+	STEP_BLOCK = 'S',
+	INDEX_BLOCK = 'I', // The keyframes' index, the last block of the file
+};
+
+struct ReplayStep // Record of a played timestep
+{
+	int timestep;
+	bool didArmiesAttack;
+	int destructedUnitsCount; // Units destroyed in the timestep
+	unsigned long long stateHash; // Lets a viewer check that the battle it rolls forward is the recorded one
+};
+
+struct ReplayKeyframe
+{
+	int timestep;
+	unsigned long long offset; // Where the keyframe's checkpoint starts in the file
+};
+
+// Records a replay while the battle is played
+class ReplayWriter
+{
+private:
+	std::ofstream file;
+	CheckpointWriter writer;
+	DynamicArray<ReplayKeyframe> keyframes;
+
+public:
+	ReplayWriter();
+
+	bool open(const std::string&); // Create the file and write the header
+	bool isOpen() const;
+	CheckpointWriter& startKeyframe(int); // Start the keyframe of the given timestep, its checkpoint is written to the returned writer
+	void writeStep(const ReplayStep&); // Record a played timestep
+	bool close(); // Write the keyframes' index and close the file, returns false if any write failed
+};
+
+// Reads a replay from the keyframe nearest to a timestep
+class ReplayReader
+{
+private:
+	std::ifstream file;
+	CheckpointReader reader;
+	DynamicArray<ReplayKeyframe> keyframes;
+
+public:
+	ReplayReader();
+
+	bool open(const std::string&); // Open the file, check its header and read the keyframes' index
+	CheckpointReader* seekKeyframe(int); // Move to the last keyframe at or before the given timestep and return the reader of its checkpoint (nullptr if there's none)
+	bool readStep(ReplayStep&); // Read the next timestep's record after the keyframe, returns false when the next keyframe or the end is reached
+};
+
+#endif
\ No newline at end of file
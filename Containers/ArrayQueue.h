@@ -0,0 +1,90 @@
+#ifndef ARRAY_QUEUE_H
+#define ARRAY_QUEUE_H
+
+#include <iostream>
+#include "QueueADT.h"
+
+// Fixed capacity queue stored inline (no heap allocation), enqueue fails when it's full
+template <typename T, int CAPACITY>
+class ArrayQueue: public QueueADT<T>
+{
+private:
+	T items[CAPACITY];
+	int front;
+	int count;
+
+public:
+	ArrayQueue();
+	bool isEmpty() const;
+	bool isFull() const;
+	bool enqueue(const T& newEntry);
+	bool dequeue(T& frontEntry);
+	bool peek(T& frontEntry) const;
+	void printList() const;
+	int getCount() const;
+};
+
+template <typename T, int CAPACITY>
+inline ArrayQueue<T, CAPACITY>::ArrayQueue(): front(0), count(0)
+{}
+
+template <typename T, int CAPACITY>
+inline bool ArrayQueue<T, CAPACITY>::isEmpty() const
+{
+	return count == 0;
+}
+
+template <typename T, int CAPACITY>
+inline bool ArrayQueue<T, CAPACITY>::isFull() const
+{
+	return count == CAPACITY;
+}
+
+template <typename T, int CAPACITY>
+inline bool ArrayQueue<T, CAPACITY>::enqueue(const T& newEntry)
+{
+	if (isFull()) return false;
+
+	items[(front + count) % CAPACITY] = newEntry;
+	count++;
+	return true;
+}
+
+template <typename T, int CAPACITY>
+inline bool ArrayQueue<T, CAPACITY>::dequeue(T& frontEntry)
+{
+	if (isEmpty()) return false;
+
+	frontEntry = items[front];
+	front = (front + 1) % CAPACITY;
+	count--;
+	return true;
+}
+
+template <typename T, int CAPACITY>
+inline bool ArrayQueue<T, CAPACITY>::peek(T& frontEntry) const
+{
+	if (isEmpty()) return false;
+
+	frontEntry = items[front];
+	return true;
+}
+
+template <typename T, int CAPACITY>
+inline void ArrayQueue<T, CAPACITY>::printList() const
+{
+	for (int i = 0; i < count; i++)
+	{
+		std::cout << items[(front + i) % CAPACITY];
+		if (i < count - 1)
+			std::cout << ", ";
+	}
+}
+
+template <typename T, int CAPACITY>
+inline int ArrayQueue<T, CAPACITY>::getCount() const
+{
+	return count;
+}
+
+#endif
\ No newline at end of file
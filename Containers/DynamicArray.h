@@ -0,0 +1,134 @@
+#ifndef DYNAMIC_ARRAY_H
+#define DYNAMIC_ARRAY_H
+
+#include <iostream>
+#include "ArrayADT.h"
+
+// Array that grows when full, clearing it keeps the reserved storage for reuse
+template <typename T>
+class DynamicArray: public ArrayADT<T>
+{
+    enum { INITIAL_CAPACITY = 16 };
+private:
+    T* items;
+    int count;
+    int capacity;
+
+private:
+    void grow();
+
+public:
+    DynamicArray();
+    bool isEmpty() const;
+    bool insert(const T& newEntry);
+    bool remove(int index, T& entry);
+    bool entryAt(T& entry, int index) const;
+    bool replace(int index, const T& newEntry);
+    void resize(int newCount);
+    void clear();
+    void printList() const;
+    int getCount() const;
+    ~DynamicArray();
+};
+
+template <typename T>
+inline DynamicArray<T>::DynamicArray(): items(nullptr), count(0), capacity(0)
+{}
+
+template <typename T>
+inline void DynamicArray<T>::grow()
+{
+    int newCapacity = capacity == 0 ? INITIAL_CAPACITY : capacity * 2;
+    T* newItems = new T[newCapacity];
+
+    for (int i = 0; i < count; i++)
+        newItems[i] = items[i];
+
+    delete[] items;
+    items = newItems;
+    capacity = newCapacity;
+}
+
+template <typename T>
+inline bool DynamicArray<T>::isEmpty() const
+{
+    return (count == 0);
+}
+
+template <typename T>
+inline bool DynamicArray<T>::insert(const T& newEntry)
+{
+    if (count == capacity) grow();
+
+    items[count++] = newEntry;
+    return true;
+}
+
+template <typename T>
+inline bool DynamicArray<T>::remove(int index, T& entry)
+{
+    if (index < 0 || index >= count) return false;
+
+    entry = items[index];
+    items[index] = items[count - 1];
+    count--;
+
+    return true;
+}
+
+template <typename T>
+inline bool DynamicArray<T>::entryAt(T& entry, int index) const
+{
+    if (index < 0 || index >= count) return false;
+
+    entry = items[index];
+    return true;
+}
+
+template <typename T>
+inline bool DynamicArray<T>::replace(int index, const T& newEntry)
+{
+    if (index < 0 || index >= count) return false;
+
+    items[index] = newEntry;
+    return true;
+}
+
+template <typename T>
+inline void DynamicArray<T>::resize(int newCount)
+{
+    while (capacity < newCount) grow();
+
+    count = newCount;
+}
+
+template <typename T>
+inline void DynamicArray<T>::clear()
+{
+    count = 0;
+}
+
+template <typename T>
+inline void DynamicArray<T>::printList() const
+{
+    for (int i = 0; i < count; i++)
+    {
+        std::cout << items[i];
+        if (i != count - 1)
+            std::cout << ", ";
+    }
+}
+
+template <typename T>
+inline int DynamicArray<T>::getCount() const
+{
+    return count;
+}
+
+template <typename T>
+inline DynamicArray<T>::~DynamicArray()
+{
+    delete[] items;
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,122 @@
+#ifndef DYNAMIC_QUEUE_H
+#define DYNAMIC_QUEUE_H
+
+#include <iostream>
+#include "QueueADT.h"
+
+// Circular array queue that grows when full, any entry can be read by its position from the front in O(1)
+template <typename T>
+class DynamicQueue: public QueueADT<T>
+{
+    enum { INITIAL_CAPACITY = 16 };
+private:
+    T* items;
+    int front;
+    int count;
+    int capacity;
+
+private:
+    void grow();
+
+public:
+    DynamicQueue();
+    bool isEmpty() const;
+    bool enqueue(const T& newEntry);
+    bool dequeue(T& frontEntry);
+    bool peek(T& frontEntry) const;
+    bool entryAt(T& entry, int index) const;
+    void printList() const;
+    int getCount() const;
+    ~DynamicQueue();
+};
+
+template <typename T>
+inline DynamicQueue<T>::DynamicQueue(): items(nullptr), front(0), count(0), capacity(0)
+{}
+
+template <typename T>
+inline void DynamicQueue<T>::grow()
+{
+    int newCapacity = capacity == 0 ? INITIAL_CAPACITY : capacity * 2;
+    T* newItems = new T[newCapacity];
+
+    // Unwrap the entries to the start of the new array
+    for (int i = 0; i < count; i++)
+        newItems[i] = items[(front + i) % capacity];
+
+    delete[] items;
+    items = newItems;
+    front = 0;
+    capacity = newCapacity;
+}
+
+template <typename T>
+inline bool DynamicQueue<T>::isEmpty() const
+{
+    return (count == 0);
+}
+
+template <typename T>
+inline bool DynamicQueue<T>::enqueue(const T& newEntry)
+{
+    if (count == capacity) grow();
+
+    items[(front + count) % capacity] = newEntry;
+    count++;
+    return true;
+}
+
+template <typename T>
+inline bool DynamicQueue<T>::dequeue(T& frontEntry)
+{
+    if (isEmpty()) return false;
+
+    frontEntry = items[front];
+    front = (front + 1) % capacity;
+    count--;
+
+    return true;
+}
+
+template <typename T>
+inline bool DynamicQueue<T>::peek(T& frontEntry) const
+{
+    if (isEmpty()) return false;
+
+    frontEntry = items[front];
+    return true;
+}
+
+template <typename T>
+inline bool DynamicQueue<T>::entryAt(T& entry, int index) const
+{
+    if (index < 0 || index >= count) return false;
+
+    entry = items[(front + index) % capacity];
+    return true;
+}
+
+template <typename T>
+inline void DynamicQueue<T>::printList() const
+{
+    for (int i = 0; i < count; i++)
+    {
+        std::cout << items[(front + i) % capacity];
+        if (i != count - 1)
+            std::cout << ", ";
+    }
+}
+
+template <typename T>
+inline int DynamicQueue<T>::getCount() const
+{
+    return count;
+}
+
+template <typename T>
+inline DynamicQueue<T>::~DynamicQueue()
+{
+    delete[] items;
+}
+
+#endif
\ No newline at end of file
@@ -13,7 +13,7 @@ enum ArmyType
 	ARMY_TOTAL,
 };
 
-enum UnitType
+enum UnitType: unsigned char
 {
 	ES, EG, ET, EH,
 	AS, AD, AM,
@@ -21,12 +21,125 @@ enum UnitType
 	UNIT_TOTAL,
 };
 
+enum AttackAction: unsigned char
+{
+	SHOTS, HEALS, INFECTS,
+	ATTACK_ACTION_TOTAL,
+};
+
+enum UnitIdRange
+{
+	EARTH_FIRST_ID = 1, EARTH_LAST_ID = 999,
+	ALIEN_FIRST_ID = 2000, ALIEN_LAST_ID = 2999,
+	EARTH_ALLIED_FIRST_ID = 4000, EARTH_ALLIED_LAST_ID = 4999,
+	UNIT_ID_TOTAL, // Size of the tables indexed by unit ID
+};
+
+enum UnitLocation
+{
+	NOT_CREATED, // No unit has this ID yet
+	IN_TRANSIT, // Out of all lists (just generated or taken by an attacker)
+	IN_ARMY, // In its army's list
+	IN_UML, // In the unit maintenance list
+	KILLED, // In the killed list (the unit object no longer exists)
+};
+
 struct Range
 {
 	int min;
 	int max;
 };
 
+struct UnitSpec // Rolled stats of a unit to be generated
+{
+	UnitType unitType;
+	int health;
+	int power;
+	int attackCapacity;
+};
+
+struct UnitLifecycle
+{
+#ifndef OUTCOME_ONLY
+	int Tj; // Join time
+	int Ta; // First attack time
+	int Td; // Destruction time
+#endif
+
+	int UMLjoinTime; // Time when the unit joined the UML
+	bool healedBefore; // If the unit has been healed before
+};
+
+enum KilledUnitFlag
+{
+	KILLED_HEALED_BEFORE = 1, // The unit has been healed before
+	KILLED_INFECTED = 2, // The earth soldier was infected when destroyed
+	KILLED_EVER_INFECTED = 4, // The earth soldier was infected or immune (has been infected before)
+};
+
+struct KilledUnitRecord
+{
+	int Td; // Destruction time
+	int Tj; // Join time
+	int Ta; // First attack time (-1 if never attacked)
+	short id;
+	UnitType unitType;
+	unsigned char flags; // Combination of KilledUnitFlag bits
+};
+
+class Unit;
+
+struct UnitIndexEntry
+{
+	Unit* unitPtr; // The unit if it still exists
+	UnitLocation location;
+};
+
+struct AttackEvent
+{
+	short attackerId;
+	UnitType attackerType;
+	AttackAction action;
+	int firstTargetIndex; // Index of the event's first target ID in the timestep's target buffer
+	int targetsCount; // The event's targets are stored contiguously
+};
+
+struct RunBudget // Limits of a run, the battle is truncated when one is reached (0 means no limit)
+{
+	int maxTimesteps;
+	int maxMilliseconds;
+};
+
+enum PlaybackMode: unsigned char // How the interactive mode continues after a timestep
+{
+	STEPPING, // Print the timestep and wait for a command
+	RUNNING, // Print nothing until the target timestep, a reached breakpoint or the end of the battle
+	AUTOPLAYING, // Print every timestep at a fixed rate until a reached breakpoint or the end of the battle
+};
+
+enum BreakCondition: unsigned char
+{
+	INFECTED_PERCENTAGE_ABOVE, // More than the given percentage of the Earth soldiers are infected
+	ARMY_UNITS_BELOW, // The army has fewer alive units than the given count
+	UNIT_DESTROYED, // The unit with the given ID is destroyed
+};
+
+struct Breakpoint
+{
+	BreakCondition condition;
+	ArmyType armyType; // The army counted by ARMY_UNITS_BELOW
+	int value; // The percentage, the units count or the unit ID
+	bool wasMet; // If the condition held at the last check, the breakpoint is reached when its condition becomes true
+};
+
+struct StepSummary
+{
+	int timestep;
+	bool didArmiesAttack; // If any of the armies attacked in this timestep
+	int destructedUnitsCount; // Units destroyed in this timestep
+	bool isOver; // If the battle ended with this timestep
+};
+
 struct ArmyStatistics
 {
 	// Total Unit Counts
@@ -1,6 +1,10 @@
 #include <iostream>
 #include <iomanip>
 #include <fstream>
+#include <sstream>
+#include <thread>
+#include <cstring>
+#include <cstdio>
 
 #include "Game.h"
 #include "UnitClasses/Unit.h"
@@ -20,58 +24,351 @@ float calculatePercentage(int numerator, int denominator) // Helper function to
 	return calculateRatio(numerator, denominator) * 100;
 }
 
-Game::Game(): gameMode(GameMode::INTERACTIVE), currentTimestep(0), earthArmy(this), alienArmy(this), earthAlliedArmy(this), randomGenerator(this)
-{}
+unsigned long long mixHashKey(unsigned long long key) // Helper function to spread the bits of a hash key (splitmix64 finalizer)
+{
+	key = (key ^ (key >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	key = (key ^ (key >> 27)) * 0x94D049BB133111EBULL;
+	return key ^ (key >> 31);
+}
 
-void Game::run(GameMode gameMode, const std::string& inputFileName, const std::string& outputFileName)
+const char* getUnitTypeLabel(UnitType unitType) // Helper function to get the label printed before a unit's ID
 {
-	// Change the game mode
-	setGameMode(gameMode);
+	const char* labels[UnitType::UNIT_TOTAL] = { "ES", "EG", "ET", "HU", "AS", "AD", "AM", "SU" };
+
+	return labels[unitType];
+}
+
+const char* getAttackActionName(AttackAction action) // Helper function to get the printed name of an attack action
+{
+	const char* names[AttackAction::ATTACK_ACTION_TOTAL] = { "shots", "heals", "infects" };
+
+	return names[action];
+}
 
+int getFirstAttackDelay(const KilledUnitRecord& record) // Helper function to calculate Df of a destroyed unit
+{
+	return record.Ta != -1 ? record.Ta - record.Tj : -1;
+}
+
+int getDestructionDelay(const KilledUnitRecord& record) // Helper function to calculate Dd of a destroyed unit
+{
+	return record.Td - record.Ta;
+}
+
+int getBattleDelay(const KilledUnitRecord& record) // Helper function to calculate Db of a destroyed unit
+{
+	return record.Td - record.Tj;
+}
+
+Game::Game(): gameMode(GameMode::INTERACTIVE),
+#ifndef OUTCOME_ONLY
+	isAttackLogEnabled(true), playbackMode(PlaybackMode::STEPPING), runTargetTimestep(0), autoplayFramesPerSecond(0),
+#endif
+	currentTimestep(0), didArmiesAttack(true), runBudget({ 0, 0 }), isBattleTruncated(false), checkpointInterval(0), keyframeInterval(0), earthArmy(this), alienArmy(this), earthAlliedArmy(this), randomGenerator(this),
+#ifndef OUTCOME_ONLY
+	traceStream(nullptr),
+#endif
+	gameStatistics()
+{
+	// No unit has been created yet
+#ifndef OUTCOME_ONLY
+	clearUnitIndex();
+#endif
+	resetUnitIds();
+}
+
+void Game::run(GameMode gameMode, const std::string& inputFileName, const std::string& outputFileName)
+{
 	// Load the parameters from the file and set the parameters in the random generator
-	if (!loadParameters(inputFileName)) // If the file is not found, print an error message and return
+	if (!load(gameMode, inputFileName, outputFileName)) // If the file is not found, print an error message and return
 	{
 		std::cout << "Error: File not found!" << std::endl;
 		return;
 	}
 
-	// Run the game
-	bool didArmiesAttack = true;
-	do
+	play();
+}
+
+void Game::resume(GameMode gameMode, const std::string& checkpointFileName, const std::string& outputFileName)
+{
+	if (!loadCheckpoint(gameMode, checkpointFileName, outputFileName))
 	{
-		// Increment Timestep
-		currentTimestep++;
+		std::cout << "Error: Invalid checkpoint file!" << std::endl;
+		return;
+	}
 
-		// Generate units for both armies
-		randomGenerator.generateUnits();
+	play();
+}
+
+void Game::replay(GameMode gameMode, const std::string& replayFileName, int timestep, const std::string& outputFileName)
+{
+	if (!seek(gameMode, replayFileName, timestep, outputFileName))
+	{
+		std::cout << "Error: Invalid replay file!" << std::endl;
+		return;
+	}
 
-		// Start fight
-		didArmiesAttack = startAttack();
+	play();
+}
 
-		// Check if earth no longer has infected soldiers  to kill the savers in the allied army
-		if (earthArmy.getInfectedSoldiersCount() == 0)
-			killSaverUnits();
+void Game::play()
+{
+	std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+	int lastCheckpointTimestep = currentTimestep;
+	int lastKeyframeTimestep = currentTimestep;
+
+	// Record the replay from the state the battle starts at
+	if (keyframeInterval > 0 && replayWriter.open(replayFileName))
+		writeCheckpoint(replayWriter.startKeyframe(currentTimestep));
+
+#ifndef OUTCOME_ONLY
+	// Log the battle from the timestep it starts at, the attack events are kept in every game mode to be logged
+	if (!battleLogFileName.empty() && battleLogWriter.open(battleLogFileName))
+		isAttackLogEnabled = true;
+#endif
+
+	// Run the game (a replay seeked to its end has nothing left to play)
+	while (!isOver() && !isBattleTruncated)
+	{
+		// Idle timesteps print nothing worth seeing in silent mode, so jump over them
+		if (gameMode == GameMode::SILENT)
+			skipIdleTimesteps();
 
-		// Spread infection in the Earth Army
-		earthArmy.spreadInfection();
+		StepSummary summary = step();
 
-		// Print the output
-		if (gameMode == GameMode::INTERACTIVE)
+		// Record the timestep, with a keyframe every keyframe interval
+		if (replayWriter.isOpen())
 		{
-			printAll();
-			std::cout << "Press Enter to continue..." << std::endl;
-			while (std::cin.get() != '\n');
+#ifdef OUTCOME_ONLY
+			unsigned long long stateHash = 0; // Not kept, a viewer can't check the battle it rolls forward
+#else
+			unsigned long long stateHash = getStateHash();
+#endif
+			ReplayStep replayStep = { summary.timestep, summary.didArmiesAttack, summary.destructedUnitsCount, stateHash };
+			replayWriter.writeStep(replayStep);
+
+			if (!isOver() && currentTimestep - lastKeyframeTimestep >= keyframeInterval)
+			{
+				writeCheckpoint(replayWriter.startKeyframe(currentTimestep));
+				lastKeyframeTimestep = currentTimestep;
+			}
+		}
+
+#ifndef OUTCOME_ONLY
+		// Wait for the user after each printed timestep, a run doesn't wait and autoplay waits for the next frame
+		if (gameMode == GameMode::INTERACTIVE && playbackMode == PlaybackMode::STEPPING)
+			readCommands();
+		else if (gameMode == GameMode::INTERACTIVE && playbackMode == PlaybackMode::AUTOPLAYING)
+			std::this_thread::sleep_for(std::chrono::milliseconds(1000 / autoplayFramesPerSecond));
+#endif
+
+		// Save the battle regularly so a long run can be resumed after an interruption (skipped timesteps count too)
+		if (checkpointInterval > 0 && !isOver() && currentTimestep - lastCheckpointTimestep >= checkpointInterval)
+		{
+			saveCheckpoint(checkpointFileName);
+			lastCheckpointTimestep = currentTimestep;
+		}
+
+		// Stop cleanly when the budget runs out, the output file describes the state reached
+		if (!isOver() && hasRunOutOfBudget(startTime))
+		{
+			isBattleTruncated = true;
+
+			// Checkpoint the state reached, so the battle can be continued with a new budget
+			if (checkpointInterval > 0 && lastCheckpointTimestep != currentTimestep)
+				saveCheckpoint(checkpointFileName);
 		}
-	} while (!battleOver(didArmiesAttack));
+	}
+
+	if (replayWriter.isOpen())
+		replayWriter.close();
+
+	finish();
+}
+
+bool Game::load(GameMode gameMode, const std::string& inputFileName, const std::string& outputFileName)
+{
+	// Start over if this game object was used for a previous battle
+	if (currentTimestep > 0)
+		reset();
+
+	// Change the game mode
+	setGameMode(gameMode);
+
+	this->outputFileName = outputFileName;
+
+	if (!loadParameters(inputFileName))
+		return false;
+
+#ifdef STREAMING_OUTPUT
+	// Killed units are written to the output file as they're destroyed
+	startOutputFile(outputFileName);
+#endif
+
+	return true;
+}
+
+StepSummary Game::step()
+{
+	int destructedUnitsBefore = gameStatistics.totalDestructedUnitsCount;
+
+	// Increment Timestep
+	currentTimestep++;
+
+#ifndef OUTCOME_ONLY
+	// Track only this timestep's changes
+	changedUnits.clear();
+	generatedUnits.clear();
+#endif
+
+	// Generate units for both armies
+	randomGenerator.generateUnits();
+
+	// Start fight
+	didArmiesAttack = startAttack();
+
+	// Check if earth no longer has infected soldiers  to kill the savers in the allied army
+	if (earthArmy.getInfectedSoldiersCount() == 0)
+		killSaverUnits();
+
+	// Spread infection in the Earth Army
+	earthArmy.spreadInfection();
+
+#ifndef OUTCOME_ONLY
+	// Trace the state reached by this timestep
+	if (traceStream)
+		writeTrace(*traceStream);
+
+	// Print the output, a run only prints the timestep it stops at
+	if (gameMode == GameMode::INTERACTIVE)
+	{
+		updatePlayback();
+
+		if (playbackMode != PlaybackMode::RUNNING)
+			printAll();
+	}
+
+	// Dispatch the timestep's events while its attack events and destroyed units are still there
+	if (isGatheringEvents())
+		dispatchTimestepEvents();
+
+	// Reuse the attack log for the next timestep
+	clearAttackEvents();
+#endif
 
+	// Free the units destroyed in this timestep now that nothing refers to them
+	freeDestroyedUnits();
+
+	StepSummary summary = { currentTimestep, didArmiesAttack, gameStatistics.totalDestructedUnitsCount - destructedUnitsBefore, isOver() };
+	return summary;
+}
+
+int Game::skipIdleTimesteps()
+{
+	int skippedTimesteps = 0;
+
+	// The timestep that may end the battle and the last timestep of the budget are left to step
+	int lastSkippedTimestep = MIN_BATTLE_TIMESTEPS - 1;
+	if (runBudget.maxTimesteps > 0 && runBudget.maxTimesteps - 1 < lastSkippedTimestep)
+		lastSkippedTimestep = runBudget.maxTimesteps - 1;
+
+	// While nothing can happen, only the generation rolls change the state
+	while (isIdle() && currentTimestep < lastSkippedTimestep && randomGenerator.skipIdleTimestep())
+	{
+		currentTimestep++;
+		skippedTimesteps++;
+
+#ifndef OUTCOME_ONLY
+		// Nothing changed in the skipped timestep, but the trace and the events still get an entry for it as if it were stepped
+		changedUnits.clear();
+		generatedUnits.clear();
+
+		if (traceStream)
+			writeTrace(*traceStream);
+
+		if (isGatheringEvents())
+			dispatchTimestepEvents();
+#endif
+	}
+
+	// As if the skipped timesteps were played, no army attacked in them
+	if (skippedTimesteps > 0)
+		didArmiesAttack = false;
+
+	return skippedTimesteps;
+}
+
+bool Game::isOver() const
+{
+	return currentTimestep > 0 && battleOver(didArmiesAttack);
+}
+
+bool Game::isTruncated() const
+{
+	return isBattleTruncated;
+}
+
+bool Game::hasRunOutOfBudget(std::chrono::steady_clock::time_point startTime) const
+{
+	if (runBudget.maxTimesteps > 0 && currentTimestep >= runBudget.maxTimesteps)
+		return true;
+
+	if (runBudget.maxMilliseconds > 0)
+	{
+		std::chrono::steady_clock::duration elapsedTime = std::chrono::steady_clock::now() - startTime;
+
+		return std::chrono::duration_cast<std::chrono::milliseconds>(elapsedTime).count() >= runBudget.maxMilliseconds;
+	}
+
+	return false;
+}
+
+void Game::finish()
+{
 	// Empty the unit maintenance list by returning the units to the appropriate army
-	emptyUnitMaintenanceList();
+	// A truncated battle hasn't ended, so its units waiting for maintenance stay alive and aren't counted as killed
+	if (!isBattleTruncated)
+		emptyUnitMaintenanceList();
 
 	// Produce the output file
 	generateOutputFile(outputFileName);
 
 	// Print the final results
 	printFinalResults();
+
+#ifndef OUTCOME_ONLY
+	if (isGatheringEvents())
+		dispatchBattleEnd();
+#endif
+}
+
+void Game::reset()
+{
+	// Delete every unit, the containers keep their reserved storage for the next battle
+	deleteAllUnits();
+#ifndef OUTCOME_ONLY
+	killedList.clear();
+	clearAttackEvents();
+	clearUnitIndex();
+	changedUnits.clear();
+	generatedUnits.clear();
+	clearBattleLogTimestep(timestepEvents);
+	breakpoints.clear();
+	playbackMode = PlaybackMode::STEPPING;
+#endif
+
+	gameStatistics = GameStatistics();
+	currentTimestep = 0;
+	didArmiesAttack = true;
+	isBattleTruncated = false;
+
+	resetUnitIds();
+	randomGenerator.reset();
+
+#ifdef STREAMING_OUTPUT
+	if (outputFile.is_open())
+		outputFile.close();
+#endif
 }
 
 bool Game::startAttack()
@@ -85,9 +382,79 @@ bool Game::startAttack()
 	return didEarthArmyAttack || didAlienArmyAttack || didEarthAlliedAttack;
 }
 
+void Game::resolveShot(Unit* attacker, Unit* target)
+{
+	// Calculate the UAP and apply the damage
+	target->receiveDamage(calcAttackPoints(attacker->getPower(), attacker->getHealth(), target->getHealth()));
+
+	// Check if the unit is dead, needs healing or can join the battle (only the aliens' shots send units to the UML)
+	if (target->isDead())
+		addToKilledList(target);
+	else if (attacker->getArmyType() == ArmyType::ALIEN && target->needsHeal())
+		addUnitToMaintenanceList(dynamic_cast<HealableUnit*>(target));
+	else
+		addUnit(target);
+
+	// Register the fought unit to be printed later
+	registerAttack(attacker, AttackAction::SHOTS, target->getId());
+}
+
+bool Game::resolveHeal(Unit* healer, HealableUnit* unit)
+{
+	// Check if unit has spent more than 10 consecutive time steps in UML
+	if (unit->hasWaitedForTooLong())
+	{
+		unit->receiveDamage(unit->getHealth()); // Make unit health 0
+		addToKilledList(unit); // Add unit to killed list
+
+		return false;
+	}
+
+	// Heal the unit with the appropriate heal power
+	// Inside receiveHeal, if unit is infected, it would apply only half of UHP so it would take as twice as long to heal
+	unit->receiveHeal(calcAttackPoints(healer->getPower(), healer->getHealth(), unit->getHealth()));
+
+	// Add the unit back to its list if completely healed, otherwise re-add to the UML
+	if (unit->isHealed())
+	{
+		// If the unit was an infected soldier, its infection is healed too and it becomes immune
+		if (unit->getUnitType() == UnitType::ES && static_cast<EarthSoldier*>(unit)->isInfected())
+		{
+			static_cast<EarthSoldier*>(unit)->loseInfection();
+			static_cast<EarthSoldier*>(unit)->gainImmunity();
+		}
+
+		addUnit(unit); // Add it to its list whether it was infected or not
+	}
+	else
+		addUnitToMaintenanceList(unit); // Add it back to the UML if not completely healed
+
+	// Register the healed unit to be printed later
+	registerAttack(healer, AttackAction::HEALS, unit->getId());
+
+	return true;
+}
+
+void Game::resolveInfection(Unit* monster, EarthSoldier* soldier)
+{
+	soldier->getInfection(); // The soldier will get infected if not infected already and not immune
+	addUnit(soldier); // The soldier will be re-enqueued to the list & infected soldiers counter will be incremented
+
+	// Register the infected soldier to be printed later
+	registerAttack(monster, AttackAction::INFECTS, soldier->getId());
+}
+
 void Game::setGameMode(GameMode gameMode)
 {
+#ifdef OUTCOME_ONLY
+	// Nothing is printed while the battle runs, so every run is silent
+	this->gameMode = GameMode::SILENT;
+#else
 	this->gameMode = gameMode;
+
+	// Only the interactive mode prints the units fighting, the observers receive them in any mode
+	isAttackLogEnabled = gameMode == GameMode::INTERACTIVE || !observers.isEmpty();
+#endif
 }
 
 bool Game::battleOver(bool didArmiesAttack) const
@@ -97,19 +464,32 @@ bool Game::battleOver(bool didArmiesAttack) const
 	bool noAttackTie = !didArmiesAttack; // If both armies weren't able to attack - considered as a tie
 
 	// Don't check for end battle condition unless it has run for at least 40 timesteps
-	return currentTimestep >= 40 && (anArmyDied || noAttackTie);
+	return currentTimestep >= MIN_BATTLE_TIMESTEPS && (anArmyDied || noAttackTie);
+}
+
+bool Game::isIdle() const
+{
+	for (int i = 0; i < UnitType::UNIT_TOTAL; i++)
+	{
+		UnitType unitType = static_cast<UnitType>(i);
+
+		if (getUnitsCount(Unit::getArmyType(unitType), unitType) > 0)
+			return false;
+	}
+
+	return unitMaintenanceList.isEmpty();
 }
 
 void Game::killSaverUnits()
 {
-	Unit* saverToKill = earthAlliedArmy.removeUnit(UnitType::SU); // Remove a saver from its list
+	Unit* saverToKill = removeUnit(ArmyType::EARTH_ALLIED, UnitType::SU); // Remove a saver from its list
 
 	while (saverToKill)
 	{
 		saverToKill->receiveDamage(saverToKill->getHealth()); // Prepare it to be killed
 		addToKilledList(saverToKill); // Add it to the killed list
 		saverToKill = nullptr;
-		saverToKill = earthAlliedArmy.removeUnit(UnitType::SU); // Remove another saver
+		saverToKill = removeUnit(ArmyType::EARTH_ALLIED, UnitType::SU); // Remove another saver
 	}
 }
 
@@ -118,12 +498,179 @@ bool Game::doesEarthNeedHelp() const
 	return earthArmy.needAllyHelp();
 }
 
+void Game::setSeed(unsigned long long seed)
+{
+	randomGenerator.setSeed(seed);
+}
+
+void Game::setRunBudget(const RunBudget& budget)
+{
+	runBudget = budget;
+}
+
+void Game::setCheckpoints(int interval, const std::string& fileName)
+{
+	checkpointInterval = interval > 0 ? interval : 0;
+	checkpointFileName = fileName;
+}
+
+void Game::setReplay(int interval, const std::string& fileName)
+{
+	keyframeInterval = interval > 0 ? interval : 0;
+	replayFileName = fileName;
+}
+
+#ifndef OUTCOME_ONLY
+void Game::setBattleLog(const std::string& fileName)
+{
+	battleLogFileName = fileName;
+}
+
+void Game::addObserver(BattleObserver* observer)
+{
+	observers.insert(observer);
+
+	// The attack events are kept in every game mode while someone observes them
+	isAttackLogEnabled = true;
+}
+
+void Game::removeObserver(BattleObserver* observer)
+{
+	BattleObserver* registeredObserver = nullptr;
+	for (int i = 0; i < observers.getCount(); i++)
+	{
+		observers.entryAt(registeredObserver, i);
+		if (registeredObserver == observer)
+		{
+			observers.remove(i, registeredObserver);
+			break;
+		}
+	}
+
+	// Without observers, the plain runs go back to skipping the attack bookkeeping
+	if (!isGatheringEvents())
+		clearBattleLogTimestep(timestepEvents);
+
+	isAttackLogEnabled = gameMode == GameMode::INTERACTIVE || isGatheringEvents();
+}
+#endif
+
+bool Game::saveCheckpoint(const std::string& fileName)
+{
+	// Write a temporary file and replace the previous checkpoint once it's complete, so an interruption never leaves a broken checkpoint
+	std::string temporaryFileName = fileName + ".tmp";
+	{
+		std::ofstream file(temporaryFileName, std::ios::binary);
+		CheckpointWriter writer(file);
+		writer.writeHeader(CheckpointFormat::CHECKPOINT_MAGIC, CheckpointFormat::CHECKPOINT_VERSION);
+		writeCheckpoint(writer);
+
+		if (!writer.isValid())
+			return false;
+	}
+
+	std::remove(fileName.c_str());
+	return std::rename(temporaryFileName.c_str(), fileName.c_str()) == 0;
+}
+
+bool Game::loadCheckpoint(GameMode gameMode, const std::string& checkpointFileName, const std::string& outputFileName)
+{
+	std::ifstream file(checkpointFileName, std::ios::binary);
+	CheckpointReader reader(file);
+	reader.readHeader(CheckpointFormat::CHECKPOINT_MAGIC, CheckpointFormat::CHECKPOINT_VERSION);
+
+	return restoreCheckpoint(gameMode, reader, outputFileName);
+}
+
+bool Game::seek(GameMode gameMode, const std::string& replayFileName, int timestep, const std::string& outputFileName)
+{
+	ReplayReader replayReader;
+	CheckpointReader* keyframeReader = replayReader.open(replayFileName) ? replayReader.seekKeyframe(timestep) : nullptr;
+
+	// Roll the battle forward silently from the keyframe
+	if (!keyframeReader || !restoreCheckpoint(GameMode::SILENT, *keyframeReader, outputFileName))
+	{
+		reset();
+		return false;
+	}
+
+#ifndef OUTCOME_ONLY
+	ReplayStep recordedStep = { 0 };
+	bool hasRecordedStep = replayReader.readStep(recordedStep);
+#endif
+
+	while (currentTimestep < timestep && !isOver())
+	{
+		step();
+
+#ifndef OUTCOME_ONLY
+		// Check the battle against the recording, a different state means the replay was recorded by a different version of the game
+		while (hasRecordedStep && recordedStep.timestep < currentTimestep)
+			hasRecordedStep = replayReader.readStep(recordedStep);
+
+		if (hasRecordedStep && recordedStep.timestep == currentTimestep && recordedStep.stateHash != stateHash)
+		{
+			reset();
+			return false;
+		}
+#endif
+	}
+
+	setGameMode(gameMode);
+	return true;
+}
+
+bool Game::restoreCheckpoint(GameMode gameMode, CheckpointReader& reader, const std::string& outputFileName)
+{
+	// The checkpoint's units are created on an empty game
+	reset();
+
+	// Change the game mode
+	setGameMode(gameMode);
+
+	this->outputFileName = outputFileName;
+
+	if (!reader.isValid() || !readCheckpoint(reader))
+	{
+		reset(); // Don't keep a half loaded battle
+		return false;
+	}
+
+#ifndef OUTCOME_ONLY
+	// The loaded units weren't generated by a step
+	changedUnits.clear();
+	generatedUnits.clear();
+#endif
+
+#ifdef STREAMING_OUTPUT
+	// Only the units killed after the checkpoint are written, the earlier rows are in the interrupted run's output file
+	startOutputFile(outputFileName);
+#endif
+
+	return true;
+}
+
+int Game::getRandomNumber(int min, int max)
+{
+	return randomGenerator.getRandomNumber(min, max);
+}
+
+int Game::getBinomialNumber(int trials, int chancePercentage)
+{
+	return randomGenerator.getBinomialNumber(trials, chancePercentage);
+}
+
+bool Game::doTanksAttackSoldiers()
+{
+	return earthArmy.willTanksAttackSoldiers();
+}
+
 void Game::printFinalResults() const
 {
 	std::cout << std::endl;
 
 	// Print an overflow error message
-	if (Unit::cantCreateEarthUnit() || Unit::cantCreateAlienUnit() || Unit::cantCreateEarthAlliedUnit())
+	if (cantCreateUnit(ArmyType::EARTH) || cantCreateUnit(ArmyType::ALIEN) || cantCreateUnit(ArmyType::EARTH_ALLIED))
 		std::cout << "Warning: The maximum number of units has been reached!" << std::endl << std::endl;
 
 	// Print battle results
@@ -146,9 +693,323 @@ void Game::emptyUnitMaintenanceList()
 	}
 }
 
+void Game::freeDestroyedUnits()
+{
+	Unit* unit = nullptr;
+
+	for (int i = 0; i < destroyedUnits.getCount(); i++)
+	{
+		destroyedUnits.entryAt(unit, i);
+#ifndef OUTCOME_ONLY
+		unitIndex[unit->getId()].unitPtr = nullptr;
+#endif
+		delete unit;
+	}
+
+	destroyedUnits.clear();
+}
+
+void Game::deleteAllUnits()
+{
+	int dummyPri = 0;
+
+	// Delete the units in the armies
+	earthArmy.clear();
+	alienArmy.clear();
+	earthAlliedArmy.clear();
+
+	// Delete the destroyed units that haven't been freed yet
+	freeDestroyedUnits();
+
+	// Delete the units in the maintenance list
+	HealableUnit* healableUnit = nullptr;
+	while (unitMaintenanceList.dequeue(healableUnit, dummyPri))
+	{
+		delete healableUnit;
+		healableUnit = nullptr;
+	}
+}
+
+#ifndef OUTCOME_ONLY
+void Game::clearUnitIndex()
+{
+	for (int i = 0; i < UnitIdRange::UNIT_ID_TOTAL; i++)
+	{
+		unitIndex[i] = { nullptr, UnitLocation::NOT_CREATED };
+		unitHashes[i] = 0;
+		unitChangeTimesteps[i] = -1;
+	}
+
+	stateHash = 0;
+}
+
+unsigned long long Game::hashUnit(const Unit* unit, UnitLocation location) const
+{
+	// Hash all the health's bits on their own, so any difference in the arithmetic shows
+	// (a double keeps its sign, exponent and high mantissa in the top bits, which don't fit beside the other fields)
+	HealthValue health = unit->getHealth();
+	unsigned long long healthBits = 0;
+	std::memcpy(&healthBits, &health, sizeof(health));
+
+	unsigned long long key = (unsigned long long) unit->getId() | (unsigned long long) location << 16 | (unsigned long long) unit->getStatusFlags() << 24;
+
+	return mixHashKey(key) ^ mixHashKey(healthBits ^ 0x9E3779B97F4A7C15ULL);
+}
+
+void Game::writeTrace(std::ostream& stream) const
+{
+	stream << currentTimestep << " " << std::hex << std::setfill('0') << std::setw(16) << stateHash << std::dec << std::setfill(' ') << "\n";
+}
+#endif
+
+void Game::writeCheckpoint(CheckpointWriter& writer)
+{
+	writer.writeInteger(currentTimestep, 4);
+	writer.writeBool(didArmiesAttack);
+
+	for (int i = 0; i < ArmyType::ARMY_TOTAL; i++)
+		writer.writeInteger(nextUnitIds[i], 2);
+
+	randomGenerator.saveState(writer);
+
+	earthArmy.saveState(writer);
+	alienArmy.saveState(writer);
+	earthAlliedArmy.saveState(writer);
+	saveUnitMaintenanceList(writer);
+
+	// Statistics
+	for (int i = 0; i < UnitType::UNIT_TOTAL; i++)
+	{
+		writer.writeInteger(gameStatistics.unitCounts[i], 4);
+		writer.writeInteger(gameStatistics.destructedUnitCounts[i], 4);
+	}
+
+	writer.writeInteger(gameStatistics.totalHealedUnits, 4);
+	writer.writeInteger(gameStatistics.totalInfectedESCount, 4);
+	writer.writeInteger(gameStatistics.totalUnitsCount, 4);
+	writer.writeInteger(gameStatistics.totalDestructedUnitsCount, 4);
+
+	for (int i = 0; i < ArmyType::ARMY_TOTAL; i++)
+	{
+		const ArmyStatistics& armyStatistics = gameStatistics.armyStatistics[i];
+
+		writer.writeInteger(armyStatistics.totalUnitsCount, 4);
+		writer.writeInteger(armyStatistics.totalDestructedUnitsCount, 4);
+		writer.writeInteger(armyStatistics.totalFirstAttackDelays, 4);
+		writer.writeInteger(armyStatistics.totalBattleDelays, 4);
+		writer.writeInteger(armyStatistics.totalDestructionDelays, 4);
+	}
+
+#ifndef OUTCOME_ONLY
+	// Killed units
+	KilledUnitRecord record = { 0 };
+	writer.writeInteger(killedList.getCount(), 4);
+	for (int i = 0; killedList.entryAt(record, i); i++)
+	{
+		writer.writeInteger(record.Td, 4);
+		writer.writeInteger(record.Tj, 4);
+		writer.writeInteger(record.Ta, 4);
+		writer.writeInteger(record.id, 2);
+		writer.writeInteger(record.unitType, 1);
+		writer.writeInteger(record.flags, 1);
+	}
+
+	// The killed units' parts of the state hash can't be recomputed from the living units
+	writer.writeInteger(stateHash, 8);
+#endif
+}
+
+bool Game::readCheckpoint(CheckpointReader& reader)
+{
+	currentTimestep = (int) reader.readInteger(4);
+	didArmiesAttack = reader.readBool();
+
+	// The units take their saved IDs while they're loaded, the counters continue from the saved values afterwards
+	int savedNextUnitIds[ArmyType::ARMY_TOTAL];
+	for (int i = 0; i < ArmyType::ARMY_TOTAL; i++)
+		savedNextUnitIds[i] = (int) reader.readInteger(2);
+
+	randomGenerator.loadState(reader);
+
+	if (!earthArmy.loadState(reader) || !alienArmy.loadState(reader) || !earthAlliedArmy.loadState(reader) || !loadUnitMaintenanceList(reader))
+		return false;
+
+	// Statistics (overwrite the counts the loaded units added when they were registered)
+	for (int i = 0; i < UnitType::UNIT_TOTAL; i++)
+	{
+		gameStatistics.unitCounts[i] = (int) reader.readInteger(4);
+		gameStatistics.destructedUnitCounts[i] = (int) reader.readInteger(4);
+	}
+
+	gameStatistics.totalHealedUnits = (int) reader.readInteger(4);
+	gameStatistics.totalInfectedESCount = (int) reader.readInteger(4);
+	gameStatistics.totalUnitsCount = (int) reader.readInteger(4);
+	gameStatistics.totalDestructedUnitsCount = (int) reader.readInteger(4);
+
+	for (int i = 0; i < ArmyType::ARMY_TOTAL; i++)
+	{
+		ArmyStatistics& armyStatistics = gameStatistics.armyStatistics[i];
+
+		armyStatistics.totalUnitsCount = (int) reader.readInteger(4);
+		armyStatistics.totalDestructedUnitsCount = (int) reader.readInteger(4);
+		armyStatistics.totalFirstAttackDelays = (int) reader.readInteger(4);
+		armyStatistics.totalBattleDelays = (int) reader.readInteger(4);
+		armyStatistics.totalDestructionDelays = (int) reader.readInteger(4);
+	}
+
+	for (int i = 0; i < ArmyType::ARMY_TOTAL; i++)
+		nextUnitIds[i] = savedNextUnitIds[i];
+
+#ifndef OUTCOME_ONLY
+	// Killed units
+	int killedCount = (int) reader.readInteger(4);
+	for (int i = 0; i < killedCount && reader.isValid(); i++)
+	{
+		KilledUnitRecord record = { 0 };
+		record.Td = (int) reader.readInteger(4);
+		record.Tj = (int) reader.readInteger(4);
+		record.Ta = (int) reader.readInteger(4);
+		record.id = (short) reader.readInteger(2);
+		record.unitType = static_cast<UnitType>(reader.readInteger(1));
+		record.flags = (unsigned char) reader.readInteger(1);
+
+		killedList.insert(record);
+	}
+
+	stateHash = reader.readInteger(8);
+
+	// Every created unit that isn't in a list was killed (no unit is in transit between timesteps)
+	const int firstIds[ArmyType::ARMY_TOTAL] = { UnitIdRange::EARTH_FIRST_ID, UnitIdRange::ALIEN_FIRST_ID, UnitIdRange::EARTH_ALLIED_FIRST_ID };
+	for (int i = 0; i < ArmyType::ARMY_TOTAL; i++)
+		for (int id = firstIds[i]; id < nextUnitIds[i] && id < UnitIdRange::UNIT_ID_TOTAL; id++)
+			if (unitIndex[id].location == UnitLocation::NOT_CREATED)
+				unitIndex[id].location = UnitLocation::KILLED;
+#endif
+
+	return reader.isValid();
+}
+
+void Game::saveUnitMaintenanceList(CheckpointWriter& writer)
+{
+	// Move the units to a second list with their priorities (equal priorities keep their order), then write them while moving them back
+	PriorityQueue<HealableUnit*> savedUnits;
+	HealableUnit* unit = nullptr;
+	int priority = 0;
+	while (unitMaintenanceList.dequeue(unit, priority))
+		savedUnits.enqueue(unit, priority);
+
+	writer.writeInteger(savedUnits.getCount(), 4);
+	while (savedUnits.dequeue(unit, priority))
+	{
+		writer.writeInteger(unit->getUnitType(), 1);
+		saveUnit(writer, unit);
+		writer.writeInteger(priority, 4);
+		unitMaintenanceList.enqueue(unit, priority);
+	}
+}
+
+bool Game::loadUnitMaintenanceList(CheckpointReader& reader)
+{
+	int unitsCount = (int) reader.readInteger(4);
+	for (int i = 0; i < unitsCount; i++)
+	{
+		// Only soldiers and tanks are healed
+		UnitType unitType = static_cast<UnitType>(reader.readInteger(1));
+		if (unitType != UnitType::ES && unitType != UnitType::ET)
+			return false;
+
+		Unit* unit = loadUnit(reader, unitType, UnitLocation::IN_UML);
+		if (!unit)
+			return false;
+
+		unitMaintenanceList.enqueue(static_cast<HealableUnit*>(unit), (int) reader.readInteger(4)); // The priority it was enqueued with
+	}
+
+	return true;
+}
+
+void Game::saveUnit(CheckpointWriter& writer, const Unit* unit) const
+{
+	UnitSpec unitSpec = unit->getSpec();
+	const UnitLifecycle& lifecycle = unitLifecycles[unit->getId()];
+
+	writer.writeInteger(unit->getId(), 2);
+	writer.writeInteger(unitSpec.unitType, 1);
+	writer.writeInteger(unitSpec.health, 1);
+	writer.writeInteger(unitSpec.power, 2);
+	writer.writeInteger(unitSpec.attackCapacity, 1);
+	writer.writeHealth(unit->getHealth());
+	writer.writeInteger(unit->getStatusFlags(), 1);
+
+#ifndef OUTCOME_ONLY
+	writer.writeInteger(lifecycle.Tj, 4);
+	writer.writeInteger(lifecycle.Ta, 4);
+	writer.writeInteger(lifecycle.Td, 4);
+#endif
+	writer.writeInteger(lifecycle.UMLjoinTime, 4);
+	writer.writeBool(lifecycle.healedBefore);
+}
+
+Unit* Game::loadUnit(CheckpointReader& reader, UnitType unitType, UnitLocation location)
+{
+	int id = (int) reader.readInteger(2);
+
+	UnitSpec unitSpec = { UnitType::SU, 0, 0, 0 };
+	unitSpec.unitType = static_cast<UnitType>(reader.readInteger(1));
+	unitSpec.health = (int) reader.readInteger(1);
+	unitSpec.power = (int) reader.readInteger(2);
+	unitSpec.attackCapacity = (int) reader.readInteger(1);
+	HealthValue health = reader.readHealth();
+	unsigned char statusFlags = (unsigned char) reader.readInteger(1);
+
+	UnitLifecycle lifecycle;
+#ifndef OUTCOME_ONLY
+	lifecycle.Tj = (int) reader.readInteger(4);
+	lifecycle.Ta = (int) reader.readInteger(4);
+	lifecycle.Td = (int) reader.readInteger(4);
+#endif
+	lifecycle.UMLjoinTime = (int) reader.readInteger(4);
+	lifecycle.healedBefore = reader.readBool();
+
+	// The unit must be of the list's type with an ID of its army
+	ArmyType armyType = Unit::getArmyType(unitType);
+	const int firstIds[ArmyType::ARMY_TOTAL] = { UnitIdRange::EARTH_FIRST_ID, UnitIdRange::ALIEN_FIRST_ID, UnitIdRange::EARTH_ALLIED_FIRST_ID };
+	const int lastIds[ArmyType::ARMY_TOTAL] = { UnitIdRange::EARTH_LAST_ID, UnitIdRange::ALIEN_LAST_ID, UnitIdRange::EARTH_ALLIED_LAST_ID };
+
+	bool isValidUnit = reader.isValid() && unitSpec.unitType == unitType && id >= firstIds[armyType] && id <= lastIds[armyType];
+#ifndef OUTCOME_ONLY
+	isValidUnit = isValidUnit && unitIndex[id].location == UnitLocation::NOT_CREATED; // Each ID is loaded once
+#endif
+
+	if (!isValidUnit)
+	{
+		reader.fail();
+		return nullptr;
+	}
+
+	// Create the unit with its saved ID, then put back its state and lifecycle record
+	nextUnitIds[armyType] = id;
+	Unit* unit = randomGenerator.createUnit(unitSpec);
+
+	unit->restoreState(health, statusFlags);
+	unitLifecycles[id] = lifecycle;
+	updateUnitIndex(unit, location);
+
+	return unit;
+}
+
+void Game::resetUnitIds()
+{
+	nextUnitIds[ArmyType::EARTH] = UnitIdRange::EARTH_FIRST_ID;
+	nextUnitIds[ArmyType::ALIEN] = UnitIdRange::ALIEN_FIRST_ID;
+	nextUnitIds[ArmyType::EARTH_ALLIED] = UnitIdRange::EARTH_ALLIED_FIRST_ID;
+}
+
 std::string Game::battleResult() const
 {
-	if (earthArmy.isDead() && !alienArmy.isDead()) // If the Earth army is dead and the Alien army is not dead, the Alien army wins
+	if (isBattleTruncated) // The budget ran out before any of the end conditions was met
+		return "Truncated!";
+	else if (earthArmy.isDead() && !alienArmy.isDead()) // If the Earth army is dead and the Alien army is not dead, the Alien army wins
 		return "Alien Army wins!";
 	else if (!earthArmy.isDead() && alienArmy.isDead()) // If the Earth army is dead and the Alien army is not dead, the Earth army wins
 		return "Earth Army wins!";
@@ -156,6 +1017,46 @@ std::string Game::battleResult() const
 		return "Draw!";
 }
 
+int Game::generateUnitId(ArmyType armyType)
+{
+	return nextUnitIds[armyType]++;
+}
+
+bool Game::cantCreateUnit(ArmyType armyType) const
+{
+	const int lastIds[ArmyType::ARMY_TOTAL] = { UnitIdRange::EARTH_LAST_ID, UnitIdRange::ALIEN_LAST_ID, UnitIdRange::EARTH_ALLIED_LAST_ID };
+
+	return nextUnitIds[armyType] > lastIds[armyType];
+}
+
+void Game::registerUnit(Unit* unit)
+{
+	UnitLifecycle& lifecycle = unitLifecycles[unit->getId()];
+
+#ifndef OUTCOME_ONLY
+	lifecycle.Tj = currentTimestep; // Set the unit's join time
+	lifecycle.Ta = -1;
+	lifecycle.Td = -1;
+#endif
+	lifecycle.UMLjoinTime = -1;
+	lifecycle.healedBefore = false;
+
+	// Count the unit in the statistics as soon as it's generated
+	ArmyType armyType = unit->getArmyType();
+	gameStatistics.unitCounts[unit->getUnitType()]++;
+	gameStatistics.totalUnitsCount++;
+	gameStatistics.armyStatistics[armyType].totalUnitsCount++;
+
+#ifndef OUTCOME_ONLY
+	// A new unit is tracked as generated rather than changed
+	unitChangeTimesteps[unit->getId()] = currentTimestep;
+	generatedUnits.insert(unit->getId());
+#endif
+
+	// The unit isn't in any list until it's added to its army
+	updateUnitIndex(unit, UnitLocation::IN_TRANSIT);
+}
+
 void Game::addUnit(Unit* unit)
 {
 	if (!unit)
@@ -177,83 +1078,125 @@ void Game::addUnit(Unit* unit)
 			earthAlliedArmy.addUnit(unit);
 			break;
 	}
+
+	updateUnitIndex(unit, UnitLocation::IN_ARMY);
 }
 
 Unit* Game::removeUnit(ArmyType armyType, UnitType unitType)
 {
+	Unit* unit = nullptr;
+
 	switch (armyType)
 	{
 		case ArmyType::EARTH:
-			return earthArmy.removeUnit(unitType);
+			unit = earthArmy.removeUnit(unitType);
+			break;
 
 		case ArmyType::ALIEN:
-			return alienArmy.removeUnit(unitType);
+			unit = alienArmy.removeUnit(unitType);
+			break;
 
 		case ArmyType::EARTH_ALLIED:
-			return earthAlliedArmy.removeUnit(unitType);
+			unit = earthAlliedArmy.removeUnit(unitType);
+			break;
 	}
 
-	return nullptr;
+	if (unit)
+		updateUnitIndex(unit, UnitLocation::IN_TRANSIT);
+
+	return unit;
 }
 
-LinkedQueue<Unit*> Game::getEnemyList(ArmyType armyType, UnitType unitType, int attackCapacity)
+void Game::getEnemyList(ArmyType armyType, UnitType unitType, int attackCapacity, TargetList& enemyUnits)
 {
-	LinkedQueue<Unit*> enemyUnits;
 	Unit* enemyUnitPtr = nullptr;
 
-	// Loop on the armies' lists depending on the attacker's attack capacity
+	// Loop on the army's list depending on the attacker's attack capacity
 	// if the required enemy unit is found, enqueue it to be sent
-	switch (armyType)
+	for (int i = 0; i < attackCapacity && !enemyUnits.isFull(); i++)
 	{
-		case ArmyType::EARTH:
-			for (int i = 0; i < attackCapacity; i++)
-			{
-				enemyUnitPtr = earthArmy.removeUnit(unitType);
-				if (enemyUnitPtr)
-					enemyUnits.enqueue(enemyUnitPtr);
-				else
-					break;
-			}
-			break;
-
-		case ArmyType::ALIEN:
-			for (int i = 0; i < attackCapacity; i++)
-			{
-				enemyUnitPtr = alienArmy.removeUnit(unitType);
-				if (enemyUnitPtr)
-					enemyUnits.enqueue(enemyUnitPtr);
-				else
-					break;
-			}
+		enemyUnitPtr = removeUnit(armyType, unitType);
+		if (enemyUnitPtr)
+			enemyUnits.enqueue(enemyUnitPtr);
+		else
 			break;
-
-		case ArmyType::EARTH_ALLIED:
-			for (int i = 0; i < attackCapacity; i++)
-			{
-				enemyUnitPtr = earthAlliedArmy.removeUnit(unitType);
-				if (enemyUnitPtr)
-					enemyUnits.enqueue(enemyUnitPtr);
-				else
-					break;
-			}
 	}
-	return enemyUnits;
 }
 
-void Game::registerAttack(Unit* currentAttacker, const std::string& currentAction, const std::string& currentFoughtUnits)
+#ifndef OUTCOME_ONLY
+void Game::logAttack(Unit* attacker, AttackAction action, int targetId)
 {
-	attackers.enqueue(currentAttacker); // Store the current attacker
-	attackActions.enqueue(currentAction); // Store the action it made
-	foughtUnits.enqueue(currentFoughtUnits); // Store the list of units the action happened on
+	// Store the target's ID in the timestep's target buffer
+	attackTargets.insert(targetId);
+
+	// Extend the last event if it's the same attacker doing the same action, otherwise start a new event
+	AttackEvent lastEvent = { 0 };
+	int lastEventIndex = attackEvents.getCount() - 1;
+
+	if (attackEvents.entryAt(lastEvent, lastEventIndex) && lastEvent.attackerId == attacker->getId() && lastEvent.action == action)
+	{
+		lastEvent.targetsCount++;
+		attackEvents.replace(lastEventIndex, lastEvent);
+		return;
+	}
+
+	AttackEvent newEvent = { (short) attacker->getId(), attacker->getUnitType(), action, attackTargets.getCount() - 1, 1 };
+
+	attackEvents.insert(newEvent);
 }
+#endif
 
 void Game::addToKilledList(Unit* unit)
 {
-	// Add the unit to the killed list
-	killedList.enqueue(unit);
+	ArmyType armyType = unit->getArmyType();
 
+#ifndef OUTCOME_ONLY
 	// Set the destruction time of the unit
 	unit->setDestructionTime(currentTimestep);
+
+	// Store a compact record of the unit in the killed list
+	const UnitLifecycle& lifecycle = unitLifecycles[unit->getId()];
+	KilledUnitRecord record = { currentTimestep, lifecycle.Tj, lifecycle.Ta, (short) unit->getId(), unit->getUnitType(), 0 };
+
+	if (lifecycle.healedBefore)
+		record.flags |= KilledUnitFlag::KILLED_HEALED_BEFORE;
+
+	if (unit->getUnitType() == UnitType::ES)
+	{
+		EarthSoldier* earthSoldier = static_cast<EarthSoldier*>(unit);
+		if (earthSoldier->isInfected())
+			record.flags |= KilledUnitFlag::KILLED_INFECTED;
+		if (earthSoldier->isInfected() || earthSoldier->isImmune()) // Check if the unit is infected or immune (has been infected before)
+			record.flags |= KilledUnitFlag::KILLED_EVER_INFECTED;
+	}
+
+#ifdef STREAMING_OUTPUT
+	writeKilledUnit(outputFile, record);
+
+	// Only the interactive mode prints the killed list, so a silent run keeps no records
+	if (gameMode == GameMode::INTERACTIVE)
+		killedList.insert(record);
+#else
+	killedList.insert(record);
+#endif
+
+	if (isGatheringEvents())
+		timestepEvents.deaths.insert(record);
+
+	// Count the unit's delays in the statistics
+	gameStatistics.armyStatistics[armyType].totalFirstAttackDelays += getFirstAttackDelay(record);
+	gameStatistics.armyStatistics[armyType].totalBattleDelays += getBattleDelay(record);
+	gameStatistics.armyStatistics[armyType].totalDestructionDelays += getDestructionDelay(record);
+#endif
+
+	// Count the destruction in the statistics
+	gameStatistics.destructedUnitCounts[unit->getUnitType()]++;
+	gameStatistics.totalDestructedUnitsCount++;
+	gameStatistics.armyStatistics[armyType].totalDestructedUnitsCount++;
+
+	// Only the unit's record remains after the unit itself is freed at the end of the timestep
+	updateUnitIndex(unit, UnitLocation::KILLED);
+	destroyedUnits.insert(unit);
 }
 
 void Game::addUnitToMaintenanceList(HealableUnit* unit)
@@ -263,30 +1206,107 @@ void Game::addUnitToMaintenanceList(HealableUnit* unit)
 
 	// Set the time when the unit joined the UML
 	unit->setUMLjoinTime(currentTimestep);
+
+	updateUnitIndex(unit, UnitLocation::IN_UML);
 }
 
-LinkedQueue<HealableUnit*> Game::getUnitsToMaintainList(int attackCapacity)
+void Game::getUnitsToMaintainList(int attackCapacity, HealTargetList& unitsToMaintain)
 {
-	LinkedQueue<HealableUnit*> unitsToMaintain;
-
 	HealableUnit* unit = nullptr;
 	int dummyPri = 0;
-	for (int i = 0; i < attackCapacity; i++)
+	for (int i = 0; i < attackCapacity && !unitsToMaintain.isFull(); i++)
 	{
 		unit = nullptr;
 		if (unitMaintenanceList.dequeue(unit, dummyPri))
+		{
 			unitsToMaintain.enqueue(unit);
+			updateUnitIndex(unit, UnitLocation::IN_TRANSIT);
+		}
 		else
 			break;
 	}
+}
+
+#ifndef OUTCOME_ONLY
+void Game::updateUnitIndex(Unit* unit, UnitLocation location)
+{
+	UnitIndexEntry& entry = unitIndex[unit->getId()];
+
+	entry.unitPtr = unit;
+	entry.location = location;
+
+	// The unit's part of the state hash changes with its list, health and status
+	unsigned long long unitHash = hashUnit(unit, location);
+	stateHash ^= unitHashes[unit->getId()] ^ unitHash;
+	unitHashes[unit->getId()] = unitHash;
+
+	// Every change of a unit passes here, track the unit once per timestep
+	if (unitChangeTimesteps[unit->getId()] != currentTimestep)
+	{
+		unitChangeTimesteps[unit->getId()] = currentTimestep;
+		changedUnits.insert(unit->getId());
+	}
+}
+
+void Game::rehashUnit(Unit* unit)
+{
+	updateUnitIndex(unit, unitIndex[unit->getId()].location);
+}
+
+void Game::registerFirstHeal()
+{
+	gameStatistics.totalHealedUnits++;
+}
+
+void Game::registerFirstInfection()
+{
+	gameStatistics.totalInfectedESCount++;
+}
+
+UnitIndexEntry Game::findUnit(int id) const
+{
+	if (id < 0 || id >= UnitIdRange::UNIT_ID_TOTAL)
+		return { nullptr, UnitLocation::NOT_CREATED };
+
+	return unitIndex[id];
+}
 
-	return unitsToMaintain;
+unsigned long long Game::getStateHash() const
+{
+	return stateHash;
+}
+
+void Game::setTraceStream(std::ostream* stream)
+{
+	traceStream = stream;
+}
+
+const DynamicArray<short>& Game::getChangedUnits() const
+{
+	return changedUnits;
+}
+
+const DynamicArray<short>& Game::getGeneratedUnits() const
+{
+	return generatedUnits;
 }
 
 void Game::printKilledList() const
 {
 	std::cout << killedList.getCount() << " units [";
-	killedList.printList();
+
+	KilledUnitRecord record = { 0 };
+	for (int i = 0; i < killedList.getCount(); i++)
+	{
+		killedList.entryAt(record, i);
+
+		std::cout << record.id;
+		if (record.flags & KilledUnitFlag::KILLED_INFECTED)
+			std::cout << "*";
+		if (i != killedList.getCount() - 1)
+			std::cout << ", ";
+	}
+
 	std::cout << "]" << std::endl;
 }
 
@@ -297,21 +1317,130 @@ void Game::printUnitMaintenanceList() const
 	std::cout << "]" << std::endl;
 }
 
-void Game::printUnitsFighting()
+void Game::groupAttackEvents(BattleLogTimestep& timestep) const
+{
+	AttackEvent event = { 0 };
+	short targetId = 0;
+
+	// Each attacker's events are consecutive, its targets are gathered action by action
+	int firstEventIndex = 0;
+	while (firstEventIndex < attackEvents.getCount())
+	{
+		AttackEvent attackerEvent = { 0 };
+		attackEvents.entryAt(attackerEvent, firstEventIndex);
+
+		int lastEventIndex = firstEventIndex;
+		while (attackEvents.entryAt(event, lastEventIndex + 1) && event.attackerId == attackerEvent.attackerId)
+			lastEventIndex++;
+
+		// The attacker is recorded with its state at the end of the timestep, it exists until the destroyed units are freed
+		Unit* attacker = findUnit(attackerEvent.attackerId).unitPtr;
+		bool isAttackerInfected = attackerEvent.attackerType == UnitType::ES && static_cast<EarthSoldier*>(attacker)->isInfected();
+		LoggedAttacker loggedAttacker = { attackerEvent.attackerId, attackerEvent.attackerType, isAttackerInfected };
+
+		for (int action = 0; action < AttackAction::ATTACK_ACTION_TOTAL; action++)
+		{
+			for (int i = firstEventIndex; i <= lastEventIndex; i++)
+			{
+				attackEvents.entryAt(event, i);
+				if (event.action != action)
+					continue;
+
+				for (int j = 0; j < event.targetsCount; j++)
+				{
+					attackTargets.entryAt(targetId, event.firstTargetIndex + j);
+					timestep.targets.insert(targetId);
+				}
+
+				loggedAttacker.targetsCounts[action] += event.targetsCount;
+			}
+		}
+
+		timestep.attackers.insert(loggedAttacker);
+		firstEventIndex = lastEventIndex + 1;
+	}
+}
+
+void Game::printUnitsFighting() const
+{
+	BattleLogTimestep timestep;
+	groupAttackEvents(timestep);
+
+	writeUnitsFighting(std::cout, timestep);
+}
+
+bool Game::isGatheringEvents() const
+{
+	return battleLogWriter.isOpen() || !observers.isEmpty();
+}
+
+void Game::dispatchTimestepEvents()
+{
+	timestepEvents.timestep = currentTimestep;
+
+	// The generated units exist until the end of the timestep even if they were destroyed in it
+	short id = 0;
+	for (int i = 0; i < generatedUnits.getCount(); i++)
+	{
+		generatedUnits.entryAt(id, i);
+		LoggedUnit loggedUnit = { id, unitIndex[id].unitPtr->getUnitType() };
+		timestepEvents.reinforcements.insert(loggedUnit);
+	}
+
+	groupAttackEvents(timestepEvents);
+
+	if (battleLogWriter.isOpen())
+		battleLogWriter.writeTimestep(timestepEvents);
+
+	BattleObserver* observer = nullptr;
+	for (int i = 0; i < observers.getCount(); i++)
+	{
+		observers.entryAt(observer, i);
+		observer->onTimestep(timestepEvents);
+	}
+
+	clearBattleLogTimestep(timestepEvents);
+}
+
+void Game::dispatchBattleEnd()
 {
-	Unit* currentAttacker = nullptr;
-	std::string currentFoughtUnits, currentAction;
+	BattleObserver* observer = nullptr;
 
-	while (attackers.dequeue(currentAttacker) && attackActions.dequeue(currentAction) && foughtUnits.dequeue(currentFoughtUnits))
+	// The units killed while emptying the maintenance list are dispatched as deaths of the last timestep
+	if (!timestepEvents.deaths.isEmpty())
 	{
-		currentAttacker->printUnit();
-		std::cout << " " << currentAction << " [" << currentFoughtUnits << "]" << std::endl;
+		timestepEvents.timestep = currentTimestep;
+
+		if (battleLogWriter.isOpen())
+			battleLogWriter.writeTimestep(timestepEvents);
+
+		for (int i = 0; i < observers.getCount(); i++)
+		{
+			observers.entryAt(observer, i);
+			observer->onTimestep(timestepEvents);
+		}
+
+		clearBattleLogTimestep(timestepEvents);
+	}
 
-		// Nullify the pointer
-		currentAttacker = nullptr;
+	BattleLogSummary summary = { battleResult(), currentTimestep, gameStatistics };
+
+	if (battleLogWriter.isOpen())
+		battleLogWriter.close(summary);
+
+	for (int i = 0; i < observers.getCount(); i++)
+	{
+		observers.entryAt(observer, i);
+		observer->onBattleEnd(summary);
 	}
 }
 
+void Game::clearAttackEvents()
+{
+	attackEvents.clear();
+	attackTargets.clear();
+}
+
 void Game::printAll()
 {
 	std::cout << std::endl;
@@ -326,7 +1455,7 @@ void Game::printAll()
 	std::cout << std::endl << "============== Earth Allied Army Alive Units ===================" << std::endl;
 	earthAlliedArmy.printArmy();
 
-	std::cout << std::endl << (attackers.isEmpty() ? "============== No units fighting at current step ==============" : "============== Units fighting at current step =================") << std::endl;
+	std::cout << std::endl << (attackEvents.isEmpty() ? "============== No units fighting at current step ==============" : "============== Units fighting at current step =================") << std::endl;
 	printUnitsFighting();
 
 	std::cout << std::endl << "============== Maintenance List Units =========================" << std::endl;
@@ -336,239 +1465,324 @@ void Game::printAll()
 	printKilledList();
 }
 
-GameStatistics Game::countStatistics()
+bool Game::isBreakpointMet(const Breakpoint& breakpoint) const
 {
-	GameStatistics gameStatistics = { 0 };
+	switch (breakpoint.condition)
+	{
+		case BreakCondition::INFECTED_PERCENTAGE_ABOVE:
+			return earthArmy.getInfectionPercentage() > breakpoint.value;
 
-	// Earth Army Statistics
-	const int earthUnitTypesCount = 4;
-	UnitType earthUnitTypes[] = { UnitType::ES, UnitType::ET, UnitType::EG, UnitType::EH };
+		case BreakCondition::ARMY_UNITS_BELOW:
+		{
+			// The units in the maintenance list are still alive
+			const ArmyStatistics& armyStatistics = gameStatistics.armyStatistics[breakpoint.armyType];
+			return armyStatistics.totalUnitsCount - armyStatistics.totalDestructedUnitsCount < breakpoint.value;
+		}
 
-	countArmyStatistics(gameStatistics, ArmyType::EARTH, earthUnitTypes, earthUnitTypesCount);
+		case BreakCondition::UNIT_DESTROYED:
+			return findUnit(breakpoint.value).location == UnitLocation::KILLED;
+	}
 
-	// Alien Army Statistics
-	const int alienUnitTypesCount = 3;
-	UnitType alienUnitTypes[] = { UnitType::AS, UnitType::AM, UnitType::AD };
+	return false;
+}
 
-	countArmyStatistics(gameStatistics, ArmyType::ALIEN, alienUnitTypes, alienUnitTypesCount);
+void Game::updatePlayback()
+{
+	// Every breakpoint is checked each timestep, so it's reached in the timestep its condition becomes true
+	bool isBreakpointReached = false;
+	Breakpoint breakpoint = { BreakCondition::INFECTED_PERCENTAGE_ABOVE };
+	for (int i = 0; i < breakpoints.getCount(); i++)
+	{
+		breakpoints.entryAt(breakpoint, i);
 
-	// Allied Army Statistics
-	const int alliedUnitTypesCount = 1;
-	UnitType alliedUnitTypes[] = { UnitType::SU };
-	countArmyStatistics(gameStatistics, ArmyType::EARTH_ALLIED, alliedUnitTypes, alliedUnitTypesCount);
+		bool isMet = isBreakpointMet(breakpoint);
+		if (isMet && !breakpoint.wasMet)
+		{
+			std::cout << std::endl << "Breakpoint " << i + 1 << " reached at timestep " << currentTimestep << std::endl;
+			isBreakpointReached = true;
+		}
 
-	// Killed Units Statistics
-	countKilledUnitsStatistics(gameStatistics);
+		breakpoint.wasMet = isMet;
+		breakpoints.replace(i, breakpoint);
+	}
 
-	return gameStatistics;
+	if (isBreakpointReached || isOver() || (playbackMode == PlaybackMode::RUNNING && currentTimestep >= runTargetTimestep))
+		playbackMode = PlaybackMode::STEPPING;
 }
 
-void Game::countArmyStatistics(GameStatistics& gameStatistics, ArmyType armyType, UnitType unitTypes[], int unitTypesCount)
+void Game::readCommands()
 {
-	// Count the statistics of the given army
-	Unit* unit = nullptr;
+	std::cout << "Press Enter to continue (or type help for the commands)..." << std::endl;
 
-	for (int i = 0; i < unitTypesCount; i++)
-	{
-		int count = getUnitsCount(armyType, unitTypes[i]);
+	// The battle continues when the input ends
+	std::string command;
+	while (std::getline(std::cin, command) && !executeCommand(command));
+}
 
-		for (int j = 0; j < count; j++)
-		{
-			// Remove the unit from the army
-			unit = removeUnit(armyType, unitTypes[i]);
+bool Game::executeCommand(const std::string& command)
+{
+	std::istringstream commandStream(command);
+	std::string name;
+	int value = 0;
 
-			// Unit Counts
-			gameStatistics.unitCounts[unitTypes[i]]++;
-			gameStatistics.totalUnitsCount++;
+	// An empty line steps a single timestep
+	if (!(commandStream >> name))
+		return true;
 
-			// Total Army Units Count
-			gameStatistics.armyStatistics[armyType].totalUnitsCount++;
+	if ((name == "run" || name == "to") && commandStream >> value)
+	{
+		int targetTimestep = name == "run" ? currentTimestep + value : value;
+		if (targetTimestep > currentTimestep)
+		{
+			playbackMode = PlaybackMode::RUNNING;
+			runTargetTimestep = targetTimestep;
+			return true;
+		}
 
-			// Count the healed units
-			HealableUnit* healableUnit = dynamic_cast<HealableUnit*>(unit);
-			if (healableUnit && healableUnit->hasBeenHealedBefore())
-				gameStatistics.totalHealedUnits++;
+		std::cout << "The battle is already at timestep " << currentTimestep << std::endl;
+		return false;
+	}
 
-			// Count the infected Earth Soldiers
-			if (unitTypes[i] == UnitType::ES)
-			{
-				EarthSoldier* earthSoldier = dynamic_cast<EarthSoldier*>(unit);
-				if (earthSoldier->isInfected() || earthSoldier->isImmune()) // Check if the unit is infected or immune (has been infected before)
-					gameStatistics.totalInfectedESCount++;
-			}
+	if (name == "auto" && commandStream >> value && value > 0)
+	{
+		playbackMode = PlaybackMode::AUTOPLAYING;
+		autoplayFramesPerSecond = value < 1000 ? value : 1000;
+		return true;
+	}
 
-			// Add the unit back to the army
-			addUnit(unit);
+	if (name == "break")
+	{
+		std::string subject;
+		commandStream >> subject >> value;
+
+		Breakpoint breakpoint = { BreakCondition::ARMY_UNITS_BELOW, ArmyType::EARTH, value, false };
+		if (subject == "infected")
+			breakpoint.condition = BreakCondition::INFECTED_PERCENTAGE_ABOVE;
+		else if (subject == "alien")
+			breakpoint.armyType = ArmyType::ALIEN;
+		else if (subject == "allied")
+			breakpoint.armyType = ArmyType::EARTH_ALLIED;
+		else if (subject == "unit")
+			breakpoint.condition = BreakCondition::UNIT_DESTROYED;
+		else if (subject != "earth")
+			commandStream.setstate(std::ios::failbit);
+
+		if (!commandStream.fail())
+		{
+			// A condition that already holds is reached only after it stops holding and becomes true again
+			breakpoint.wasMet = isBreakpointMet(breakpoint);
+			breakpoints.insert(breakpoint);
 
-			// Nullify the pointer
-			unit = nullptr;
+			std::cout << "Breakpoint " << breakpoints.getCount() << " set" << std::endl;
+			return false;
 		}
 	}
-}
 
-void Game::countKilledUnitsStatistics(GameStatistics& gameStatistics)
-{
-	Unit* unit = nullptr;
-	int count = killedList.getCount();
-
-	for (int i = 0; i < count; i++)
+	if (name == "clear")
 	{
-		// Remove the unit from the killed list
-		killedList.dequeue(unit);
-
-		// Get the unit type and army type
-		ArmyType armyType = unit->getArmyType();
-		UnitType unitType = unit->getUnitType();
+		breakpoints.clear();
+		std::cout << "Breakpoints cleared" << std::endl;
+		return false;
+	}
 
-		// Unit Counts
-		gameStatistics.unitCounts[unitType]++;
-		gameStatistics.totalUnitsCount++;
+	std::cout << "Commands:" << std::endl;
+	std::cout << "  (Enter)                     Play the next timestep" << std::endl;
+	std::cout << "  run N                       Play N timesteps printing only the last one" << std::endl;
+	std::cout << "  to T                        Play up to timestep T printing only the last one" << std::endl;
+	std::cout << "  auto F                      Print F timesteps per second" << std::endl;
+	std::cout << "  break infected P            Stop when more than P% of the Earth soldiers are infected" << std::endl;
+	std::cout << "  break earth|alien|allied K  Stop when the army has fewer than K alive units" << std::endl;
+	std::cout << "  break unit X                Stop when the unit with ID X is destroyed" << std::endl;
+	std::cout << "  clear                       Remove all breakpoints" << std::endl;
+	std::cout << "Running and autoplay stop at a reached breakpoint and at the end of the battle" << std::endl;
+
+	return false;
+}
+#endif
 
-		// Destructed Unit Counts
-		gameStatistics.destructedUnitCounts[unitType]++;
-		gameStatistics.totalDestructedUnitsCount++;
+void Game::generateOutputFile(const std::string& outputFileName)
+{
+#if defined(OUTCOME_ONLY)
+	// Only the winner and the battle length are known
+	std::ofstream fout(outputFileName);
+	writeBattleResults(fout, battleResult(), currentTimestep);
+	fout.close();
+#elif defined(STREAMING_OUTPUT)
+	// The killed units are already written, the summary is written after them from the running totals
+	outputFile << std::endl;
+	writeBattleResults(outputFile, battleResult(), currentTimestep);
+	writeStatistics(outputFile, gameStatistics);
 
-		// Total Army Units Count
-		gameStatistics.armyStatistics[armyType].totalUnitsCount++;
-		gameStatistics.armyStatistics[armyType].totalDestructedUnitsCount++;
+	// Close the output file
+	outputFile.close();
+#else
+	// Open the output file
+	std::ofstream fout(outputFileName);
 
-		// Count the healed units
-		HealableUnit* healableUnit = dynamic_cast<HealableUnit*>(unit);
-		if (healableUnit && healableUnit->hasBeenHealedBefore())
-			gameStatistics.totalHealedUnits++;
+	writeBattleResults(fout, battleResult(), currentTimestep);
 
-		// Count the infected Earth Soldiers
-		if (unitType == UnitType::ES)
-		{
-			EarthSoldier* earthSoldier = dynamic_cast<EarthSoldier*>(unit);
-			if (earthSoldier->isInfected() || earthSoldier->isImmune()) // Check if the unit is infected or immune (has been infected before)
-				gameStatistics.totalInfectedESCount++;
-		}
+	fout << std::endl;
+	writeKilledUnitsHeader(fout);
 
-		// Delays
-		gameStatistics.armyStatistics[armyType].totalFirstAttackDelays += unit->getFirstAttackDelay();
-		gameStatistics.armyStatistics[armyType].totalBattleDelays += unit->getBattleDelay();
-		gameStatistics.armyStatistics[armyType].totalDestructionDelays += unit->getDestructionDelay();
+	// Print the units
+	KilledUnitRecord killedUnit = { 0 };
+	for (int i = 0; i < killedList.getCount(); i++)
+	{
+		killedList.entryAt(killedUnit, i);
+		writeKilledUnit(fout, killedUnit);
+	}
 
-		// Add the unit back to the killed list
-		killedList.enqueue(unit);
+	writeStatistics(fout, gameStatistics);
 
-		// Nullify the pointer
-		unit = nullptr;
-	}
+	// Close the output file
+	fout.close();
+#endif
 }
 
-void Game::generateOutputFile(const std::string& outputFileName)
+#ifdef STREAMING_OUTPUT
+void Game::startOutputFile(const std::string& outputFileName)
 {
-	// Open the output file
-	std::ofstream fout(outputFileName);
+	// Open the output file for the whole run, the stream buffers the rows written as units are destroyed
+	outputFile.open(outputFileName);
 
-	// Count the statistics
-	GameStatistics gameStatistics = countStatistics();
+	writeKilledUnitsHeader(outputFile);
+}
+#endif
 
+void Game::writeBattleResults(std::ostream& stream, const std::string& result, int totalTimesteps)
+{
 	// Print decorated the battle results
-	fout << "======================================================================" << std::endl;
-	fout << std::right << std::setw(40);
-	fout << "Battle Results" << std::endl;
-	fout << "======================================================================" << std::endl;
-	fout << "Battle Result: " << battleResult() << std::endl;
-	fout << "Total Timesteps: " << currentTimestep << std::endl;
+	stream << "======================================================================" << std::endl;
+	stream << std::right << std::setw(40);
+	stream << "Battle Results" << std::endl;
+	stream << "======================================================================" << std::endl;
+	stream << "Battle Result: " << result << std::endl;
+	stream << "Total Timesteps: " << totalTimesteps << std::endl;
+}
 
+#ifndef OUTCOME_ONLY
+void Game::writeKilledUnitsHeader(std::ostream& stream)
+{
 	// Print the killed units
-	fout << std::endl;
-	fout << "======================================================================" << std::endl;
-	fout << std::right << std::setw(40);
-	fout << "Killed Units" << std::endl;
-	fout << "======================================================================" << std::endl;
+	stream << "======================================================================" << std::endl;
+	stream << std::right << std::setw(40);
+	stream << "Killed Units" << std::endl;
+	stream << "======================================================================" << std::endl;
 
 	// Print the header
-	fout << std::left;
-	fout << std::setw(12) << "Td";
-	fout << std::setw(12) << "ID";
-	fout << std::setw(12) << "Tj";
-	fout << std::setw(12) << "Df";
-	fout << std::setw(12) << "Dd";
-	fout << std::setw(12) << "Db" << std::endl;
-
-	// Print the units
-	Unit* killedUnit = nullptr;
-	for (int i = 0; i < gameStatistics.totalDestructedUnitsCount; i++)
-	{
-		killedList.dequeue(killedUnit);
-
-		fout << std::setw(12) << killedUnit->getDestructionTime();
-		fout << std::setw(12) << killedUnit->getId();
-		fout << std::setw(12) << killedUnit->getJoinTime();
-		fout << std::setw(12) << killedUnit->getFirstAttackDelay();
-		fout << std::setw(12) << killedUnit->getDestructionDelay();
-		fout << std::setw(12) << killedUnit->getBattleDelay() << std::endl;
+	stream << std::left;
+	stream << std::setw(12) << "Td";
+	stream << std::setw(12) << "ID";
+	stream << std::setw(12) << "Tj";
+	stream << std::setw(12) << "Df";
+	stream << std::setw(12) << "Dd";
+	stream << std::setw(12) << "Db" << std::endl;
+}
 
-		killedList.enqueue(killedUnit);
-	}
+void Game::writeKilledUnit(std::ostream& stream, const KilledUnitRecord& killedUnit)
+{
+	// Rows end with a plain newline so streamed rows don't flush the output file one by one
+	stream << std::setw(12) << killedUnit.Td;
+	stream << std::setw(12) << killedUnit.id;
+	stream << std::setw(12) << killedUnit.Tj;
+	stream << std::setw(12) << getFirstAttackDelay(killedUnit);
+	stream << std::setw(12) << getDestructionDelay(killedUnit);
+	stream << std::setw(12) << getBattleDelay(killedUnit) << "\n";
+}
 
+void Game::writeStatistics(std::ostream& stream, const GameStatistics& statistics)
+{
 	// Earth Army Statistics
-	fout << std::endl;
-	fout << "======================================================================" << std::endl;
-	fout << std::right << std::setw(45);
-	fout << "Earth Army Statistics" << std::endl;
-	fout << "======================================================================" << std::endl;
-	fout << "Total ES Count: " << gameStatistics.unitCounts[UnitType::ES] << std::endl;
-	fout << "Total ET Count: " << gameStatistics.unitCounts[UnitType::ET] << std::endl;
-	fout << "Total EG Count: " << gameStatistics.unitCounts[UnitType::EG] << std::endl;
-	fout << "Total EH Count: " << gameStatistics.unitCounts[UnitType::EH] << std::endl;
-	fout << "======================================================================" << std::endl;
-	fout << "Destructed ESs/Total ESs = " << calculatePercentage(gameStatistics.destructedUnitCounts[UnitType::ES], gameStatistics.unitCounts[UnitType::ES]) << "%" << std::endl;
-	fout << "Destructed ETs/Total ETs = " << calculatePercentage(gameStatistics.destructedUnitCounts[UnitType::ET], gameStatistics.unitCounts[UnitType::ET]) << "%" << std::endl;
-	fout << "Destructed EGs/Total EGs = " << calculatePercentage(gameStatistics.destructedUnitCounts[UnitType::EG], gameStatistics.unitCounts[UnitType::EG]) << "%" << std::endl;
-	fout << "Destructed EHs/Total EHs = " << calculatePercentage(gameStatistics.destructedUnitCounts[UnitType::EH], gameStatistics.unitCounts[UnitType::EH]) << "%" << std::endl;
-	fout << "Total Destructed Earth Units/Total Earth Units = " << calculatePercentage(gameStatistics.armyStatistics[ArmyType::EARTH].totalDestructedUnitsCount, gameStatistics.armyStatistics[ArmyType::EARTH].totalUnitsCount) << "%" << std::endl;
-	fout << "Total Healed Units/Total Earth Units = " << calculatePercentage(gameStatistics.totalHealedUnits, gameStatistics.armyStatistics[ArmyType::EARTH].totalUnitsCount) << "%" << std::endl;
-	fout << "Total Infected ESs/Total Earth Units = " << calculatePercentage(gameStatistics.totalInfectedESCount, gameStatistics.armyStatistics[ArmyType::EARTH].totalUnitsCount) << "%" << std::endl;
-	fout << "======================================================================" << std::endl;
-	fout << "Average of First Attack Delay = " << calculateRatio(gameStatistics.armyStatistics[ArmyType::EARTH].totalFirstAttackDelays, gameStatistics.armyStatistics[ArmyType::EARTH].totalUnitsCount) << std::endl;
-	fout << "Average of Destruction Delay = " << calculateRatio(gameStatistics.armyStatistics[ArmyType::EARTH].totalDestructionDelays, gameStatistics.armyStatistics[ArmyType::EARTH].totalUnitsCount) << std::endl;
-	fout << "Average of Battle Delay = " << calculateRatio(gameStatistics.armyStatistics[ArmyType::EARTH].totalBattleDelays, gameStatistics.armyStatistics[ArmyType::EARTH].totalUnitsCount) << std::endl;
-	fout << "======================================================================" << std::endl;
-	fout << "Df/Db = " << calculatePercentage(gameStatistics.armyStatistics[ArmyType::EARTH].totalFirstAttackDelays, gameStatistics.armyStatistics[ArmyType::EARTH].totalBattleDelays) << "%" << std::endl;
-	fout << "Dd/Db = " << calculatePercentage(gameStatistics.armyStatistics[ArmyType::EARTH].totalDestructionDelays, gameStatistics.armyStatistics[ArmyType::EARTH].totalBattleDelays) << "%" << std::endl;
+	stream << std::endl;
+	stream << "======================================================================" << std::endl;
+	stream << std::right << std::setw(45);
+	stream << "Earth Army Statistics" << std::endl;
+	stream << "======================================================================" << std::endl;
+	stream << "Total ES Count: " << statistics.unitCounts[UnitType::ES] << std::endl;
+	stream << "Total ET Count: " << statistics.unitCounts[UnitType::ET] << std::endl;
+	stream << "Total EG Count: " << statistics.unitCounts[UnitType::EG] << std::endl;
+	stream << "Total EH Count: " << statistics.unitCounts[UnitType::EH] << std::endl;
+	stream << "======================================================================" << std::endl;
+	stream << "Destructed ESs/Total ESs = " << calculatePercentage(statistics.destructedUnitCounts[UnitType::ES], statistics.unitCounts[UnitType::ES]) << "%" << std::endl;
+	stream << "Destructed ETs/Total ETs = " << calculatePercentage(statistics.destructedUnitCounts[UnitType::ET], statistics.unitCounts[UnitType::ET]) << "%" << std::endl;
+	stream << "Destructed EGs/Total EGs = " << calculatePercentage(statistics.destructedUnitCounts[UnitType::EG], statistics.unitCounts[UnitType::EG]) << "%" << std::endl;
+	stream << "Destructed EHs/Total EHs = " << calculatePercentage(statistics.destructedUnitCounts[UnitType::EH], statistics.unitCounts[UnitType::EH]) << "%" << std::endl;
+	stream << "Total Destructed Earth Units/Total Earth Units = " << calculatePercentage(statistics.armyStatistics[ArmyType::EARTH].totalDestructedUnitsCount, statistics.armyStatistics[ArmyType::EARTH].totalUnitsCount) << "%" << std::endl;
+	stream << "Total Healed Units/Total Earth Units = " << calculatePercentage(statistics.totalHealedUnits, statistics.armyStatistics[ArmyType::EARTH].totalUnitsCount) << "%" << std::endl;
+	stream << "Total Infected ESs/Total Earth Units = " << calculatePercentage(statistics.totalInfectedESCount, statistics.armyStatistics[ArmyType::EARTH].totalUnitsCount) << "%" << std::endl;
+	stream << "======================================================================" << std::endl;
+	stream << "Average of First Attack Delay = " << calculateRatio(statistics.armyStatistics[ArmyType::EARTH].totalFirstAttackDelays, statistics.armyStatistics[ArmyType::EARTH].totalUnitsCount) << std::endl;
+	stream << "Average of Destruction Delay = " << calculateRatio(statistics.armyStatistics[ArmyType::EARTH].totalDestructionDelays, statistics.armyStatistics[ArmyType::EARTH].totalUnitsCount) << std::endl;
+	stream << "Average of Battle Delay = " << calculateRatio(statistics.armyStatistics[ArmyType::EARTH].totalBattleDelays, statistics.armyStatistics[ArmyType::EARTH].totalUnitsCount) << std::endl;
+	stream << "======================================================================" << std::endl;
+	stream << "Df/Db = " << calculatePercentage(statistics.armyStatistics[ArmyType::EARTH].totalFirstAttackDelays, statistics.armyStatistics[ArmyType::EARTH].totalBattleDelays) << "%" << std::endl;
+	stream << "Dd/Db = " << calculatePercentage(statistics.armyStatistics[ArmyType::EARTH].totalDestructionDelays, statistics.armyStatistics[ArmyType::EARTH].totalBattleDelays) << "%" << std::endl;
 
 	// Alien Army Statistics
-	fout << std::endl;
-	fout << "======================================================================" << std::endl;
-	fout << std::right << std::setw(45);
-	fout << "Alien Army Statistics" << std::endl;
-	fout << "======================================================================" << std::endl;
-	fout << "Total AS Count: " << gameStatistics.unitCounts[UnitType::AS] << std::endl;
-	fout << "Total AM Count: " << gameStatistics.unitCounts[UnitType::AM] << std::endl;
-	fout << "Total AD Count: " << gameStatistics.unitCounts[UnitType::AD] << std::endl;
-	fout << "======================================================================" << std::endl;
-	fout << "Destructed ASs/Total ASs = " << calculatePercentage(gameStatistics.destructedUnitCounts[UnitType::AS], gameStatistics.unitCounts[UnitType::AS]) << "%" << std::endl;
-	fout << "Destructed AMs/Total AMs = " << calculatePercentage(gameStatistics.destructedUnitCounts[UnitType::AM], gameStatistics.unitCounts[UnitType::AM]) << "%" << std::endl;
-	fout << "Destructed ATs/Total ATs = " << calculatePercentage(gameStatistics.destructedUnitCounts[UnitType::AD], gameStatistics.unitCounts[UnitType::AD]) << "%" << std::endl;
-	fout << "Total Destructed Alien Units/Total Alien Units = " << calculatePercentage(gameStatistics.armyStatistics[ArmyType::ALIEN].totalDestructedUnitsCount, gameStatistics.armyStatistics[ArmyType::ALIEN].totalUnitsCount) << "%" << std::endl;
-	fout << "======================================================================" << std::endl;
-	fout << "Average of First Attack Delay = " << calculateRatio(gameStatistics.armyStatistics[ArmyType::ALIEN].totalFirstAttackDelays, gameStatistics.armyStatistics[ArmyType::ALIEN].totalUnitsCount) << std::endl;
-	fout << "Average of Destruction Delay = " << calculateRatio(gameStatistics.armyStatistics[ArmyType::ALIEN].totalDestructionDelays, gameStatistics.armyStatistics[ArmyType::ALIEN].totalUnitsCount) << std::endl;
-	fout << "Average of Battle Delay = " << calculateRatio(gameStatistics.armyStatistics[ArmyType::ALIEN].totalBattleDelays, gameStatistics.armyStatistics[ArmyType::ALIEN].totalUnitsCount) << std::endl;
-	fout << "======================================================================" << std::endl;
-	fout << "Df/Db = " << calculatePercentage(gameStatistics.armyStatistics[ArmyType::ALIEN].totalFirstAttackDelays, gameStatistics.armyStatistics[ArmyType::ALIEN].totalBattleDelays) << "%" << std::endl;
-	fout << "Dd/Db = " << calculatePercentage(gameStatistics.armyStatistics[ArmyType::ALIEN].totalDestructionDelays, gameStatistics.armyStatistics[ArmyType::ALIEN].totalBattleDelays) << "%" << std::endl;
+	stream << std::endl;
+	stream << "======================================================================" << std::endl;
+	stream << std::right << std::setw(45);
+	stream << "Alien Army Statistics" << std::endl;
+	stream << "======================================================================" << std::endl;
+	stream << "Total AS Count: " << statistics.unitCounts[UnitType::AS] << std::endl;
+	stream << "Total AM Count: " << statistics.unitCounts[UnitType::AM] << std::endl;
+	stream << "Total AD Count: " << statistics.unitCounts[UnitType::AD] << std::endl;
+	stream << "======================================================================" << std::endl;
+	stream << "Destructed ASs/Total ASs = " << calculatePercentage(statistics.destructedUnitCounts[UnitType::AS], statistics.unitCounts[UnitType::AS]) << "%" << std::endl;
+	stream << "Destructed AMs/Total AMs = " << calculatePercentage(statistics.destructedUnitCounts[UnitType::AM], statistics.unitCounts[UnitType::AM]) << "%" << std::endl;
+	stream << "Destructed ATs/Total ATs = " << calculatePercentage(statistics.destructedUnitCounts[UnitType::AD], statistics.unitCounts[UnitType::AD]) << "%" << std::endl;
+	stream << "Total Destructed Alien Units/Total Alien Units = " << calculatePercentage(statistics.armyStatistics[ArmyType::ALIEN].totalDestructedUnitsCount, statistics.armyStatistics[ArmyType::ALIEN].totalUnitsCount) << "%" << std::endl;
+	stream << "======================================================================" << std::endl;
+	stream << "Average of First Attack Delay = " << calculateRatio(statistics.armyStatistics[ArmyType::ALIEN].totalFirstAttackDelays, statistics.armyStatistics[ArmyType::ALIEN].totalUnitsCount) << std::endl;
+	stream << "Average of Destruction Delay = " << calculateRatio(statistics.armyStatistics[ArmyType::ALIEN].totalDestructionDelays, statistics.armyStatistics[ArmyType::ALIEN].totalUnitsCount) << std::endl;
+	stream << "Average of Battle Delay = " << calculateRatio(statistics.armyStatistics[ArmyType::ALIEN].totalBattleDelays, statistics.armyStatistics[ArmyType::ALIEN].totalUnitsCount) << std::endl;
+	stream << "======================================================================" << std::endl;
+	stream << "Df/Db = " << calculatePercentage(statistics.armyStatistics[ArmyType::ALIEN].totalFirstAttackDelays, statistics.armyStatistics[ArmyType::ALIEN].totalBattleDelays) << "%" << std::endl;
+	stream << "Dd/Db = " << calculatePercentage(statistics.armyStatistics[ArmyType::ALIEN].totalDestructionDelays, statistics.armyStatistics[ArmyType::ALIEN].totalBattleDelays) << "%" << std::endl;
 
 	// Allied Army Statistics
-	fout << std::endl;
-	fout << "======================================================================" << std::endl;
-	fout << std::right << std::setw(45);
-	fout << "Earth Allied Army Statistics" << std::endl;
-	fout << "======================================================================" << std::endl;
-	fout << "Total SU Count: " << gameStatistics.unitCounts[UnitType::SU] << std::endl;
-	fout << "======================================================================" << std::endl;
-	fout << "Destructed SUs/Total SUs = " << calculatePercentage(gameStatistics.destructedUnitCounts[UnitType::SU], gameStatistics.unitCounts[UnitType::SU]) << "%" << std::endl;
-	fout << "======================================================================" << std::endl;
-	fout << "Average of Battle Delay = " << calculateRatio(gameStatistics.armyStatistics[ArmyType::EARTH_ALLIED].totalBattleDelays, gameStatistics.armyStatistics[ArmyType::EARTH_ALLIED].totalUnitsCount) << std::endl;
+	stream << std::endl;
+	stream << "======================================================================" << std::endl;
+	stream << std::right << std::setw(45);
+	stream << "Earth Allied Army Statistics" << std::endl;
+	stream << "======================================================================" << std::endl;
+	stream << "Total SU Count: " << statistics.unitCounts[UnitType::SU] << std::endl;
+	stream << "======================================================================" << std::endl;
+	stream << "Destructed SUs/Total SUs = " << calculatePercentage(statistics.destructedUnitCounts[UnitType::SU], statistics.unitCounts[UnitType::SU]) << "%" << std::endl;
+	stream << "======================================================================" << std::endl;
+	stream << "Average of Battle Delay = " << calculateRatio(statistics.armyStatistics[ArmyType::EARTH_ALLIED].totalBattleDelays, statistics.armyStatistics[ArmyType::EARTH_ALLIED].totalUnitsCount) << std::endl;
+}
 
-	// Close the output file
-	fout.close();
+void Game::writeUnitsFighting(std::ostream& stream, const BattleLogTimestep& timestep)
+{
+	LoggedAttacker attacker = { 0 };
+	short targetId = 0;
+	int targetIndex = 0;
+
+	// A line per action the attacker did, its targets are stored in the actions' order
+	for (int i = 0; i < timestep.attackers.getCount(); i++)
+	{
+		timestep.attackers.entryAt(attacker, i);
+
+		for (int action = 0; action < AttackAction::ATTACK_ACTION_TOTAL; action++)
+		{
+			if (attacker.targetsCounts[action] == 0)
+				continue;
+
+			stream << getUnitTypeLabel(attacker.unitType) << " " << attacker.id << (attacker.isInfected ? "*" : "");
+			stream << " " << getAttackActionName((AttackAction) action) << " [";
+
+			for (int j = 0; j < attacker.targetsCounts[action]; j++)
+			{
+				timestep.targets.entryAt(targetId, targetIndex++);
+				stream << (j == 0 ? "" : ", ") << targetId;
+			}
+
+			stream << "]" << std::endl;
+		}
+	}
 }
+#endif
 
 bool Game::loadParameters(const std::string& fileName)
 {
@@ -628,8 +1842,8 @@ bool Game::loadParameters(const std::string& fileName)
 		randomGenerator.setAlienParameters(ASPercentage, AMPercentage, ADPercentage, alienPowerRange, alienHealthRange, alienAttackCapacityRange); // Set the parameters for the Alien army
 		randomGenerator.setEarthAlliedParameters(earthAlliedPowerRange, earthAlliedHealthRange, earthAlliedAttackCapacityRange);
 
-		AlienMonster::setInfectingProbability(infectingProbability); // Set the infecting probability for the Alien Monster
-		EarthArmy::setInfectionThreshold(infectionThreshold); // Set the infection threshold percentage for the Earth Army
+		alienArmy.setInfectingProbability(infectingProbability); // Set the infecting probability for the Alien Monster
+		earthArmy.setInfectionThreshold(infectionThreshold); // Set the infection threshold percentage for the Earth Army
 
 		fin.close(); // Close the file
 
@@ -665,23 +1879,27 @@ int Game::getInfectedUnitsCount() const
 	return earthArmy.getInfectedSoldiersCount();
 }
 
-Game::~Game()
+int Game::getInfectingProbability() const
 {
-	Unit* unit = nullptr;
-	int dummyPri = 0;
+	return alienArmy.getInfectingProbability();
+}
 
-	// Delete the units in the killed list
-	while (killedList.dequeue(unit))
-	{
-		delete unit;
-		unit = nullptr;
-	}
+const GameStatistics& Game::getStatistics() const
+{
+	return gameStatistics;
+}
 
-	// Delete the units in the maintenance list
-	HealableUnit* healableUnit = nullptr;
-	while (unitMaintenanceList.dequeue(healableUnit, dummyPri))
-	{
-		delete healableUnit;
-		healableUnit = nullptr;
-	}
+UnitLifecycle& Game::getUnitLifecycle(int id)
+{
+	return unitLifecycles[id];
+}
+
+const UnitLifecycle& Game::getUnitLifecycle(int id) const
+{
+	return unitLifecycles[id];
+}
+
+Game::~Game()
+{
+	deleteAllUnits();
 }
\ No newline at end of file
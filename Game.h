@@ -2,80 +2,249 @@
 #define GAME_H
 
 #include <string>
+#include <fstream>
+#include <chrono>
 
 #include "DEFS.h"
 #include "ArmyClasses/EarthArmy.h"
 #include "ArmyClasses/AlienArmy.h"
 #include "ArmyClasses/EarthAlliedArmy.h"
 #include "RandomGenerator/RandomGenerator.h"
+#include "Checkpoint/Checkpoint.h"
+#include "Checkpoint/Replay.h"
+#include "BattleLog/BattleLog.h"
+#include "BattleLog/BattleObserver.h"
 #include "Containers/LinkedQueue.h"
 #include "Containers/PriorityQueue.h"
+#include "Containers/DynamicArray.h"
 #include "UnitClasses/HealableUnit.h"
 
 class Game
 {
 private:
+    enum { MIN_BATTLE_TIMESTEPS = 40 }; // The battle can't end before this timestep
     GameMode gameMode;
+#ifndef OUTCOME_ONLY
+    bool isAttackLogEnabled; // Logging policy chosen with the game mode, only the interactive mode prints the attack log
+    PlaybackMode playbackMode; // How the interactive mode continues after the current timestep
+    int runTargetTimestep; // The timestep running stops at
+    int autoplayFramesPerSecond; // Timesteps printed per second while autoplaying
+    DynamicArray<Breakpoint> breakpoints; // Conditions that stop running and autoplaying in the interactive mode
+#endif
     int currentTimestep;
+    bool didArmiesAttack; // If any of the armies attacked in the last timestep
+    RunBudget runBudget; // Limits of the timesteps and time run can take
+    bool isBattleTruncated; // If run stopped because the budget ran out before the battle ended
+    std::string outputFileName;
+    int checkpointInterval; // Timesteps between the checkpoints run writes (0 writes none)
+    std::string checkpointFileName;
+    int keyframeInterval; // Timesteps between the keyframes of the replay run records (0 records no replay)
+    std::string replayFileName;
+    ReplayWriter replayWriter;
+#ifndef OUTCOME_ONLY
+    std::string battleLogFileName; // Where run writes the battle log (empty writes none)
+    BattleLogWriter battleLogWriter;
+    DynamicArray<BattleObserver*> observers; // Registered observers (not owned by the game)
+    BattleLogTimestep timestepEvents; // Events of the current timestep gathered for the battle log and the observers
+#endif
 
     EarthArmy earthArmy;
     AlienArmy alienArmy;
     EarthAlliedArmy earthAlliedArmy;
     RandomGenerator randomGenerator;
 
-    LinkedQueue<Unit*> attackers; // Attackers of the current time step
-    LinkedQueue<std::string> foughtUnits; // Units attacked by each attacker in the current timestep
-    LinkedQueue<std::string> attackActions; // Action done on the unit of the opposite army
+#ifndef OUTCOME_ONLY
+    DynamicArray<AttackEvent> attackEvents; // Attacks of the current timestep, formatted only when printed
+    DynamicArray<short> attackTargets; // IDs of the units each attack event happened on
 
-    LinkedQueue<Unit*> killedList;
+    DynamicArray<KilledUnitRecord> killedList; // Compact records of the destroyed units in destruction order
+#endif
+    DynamicArray<Unit*> destroyedUnits; // Destroyed units freed at the end of the timestep (their index entries are used when printing the attack log)
     PriorityQueue<HealableUnit*> unitMaintenanceList;
 
+    UnitLifecycle unitLifecycles[UnitIdRange::UNIT_ID_TOTAL]; // Side table of the units' cold lifecycle data indexed by ID
+#ifndef OUTCOME_ONLY
+    UnitIndexEntry unitIndex[UnitIdRange::UNIT_ID_TOTAL]; // Where each unit currently is indexed by ID
+    unsigned long long unitHashes[UnitIdRange::UNIT_ID_TOTAL]; // Each unit's current part of the state hash indexed by ID
+    unsigned long long stateHash; // XOR of the units' parts, updated whenever a unit changes its list or state
+    std::ostream* traceStream; // Receives the state hash after every timestep when set
+
+    int unitChangeTimesteps[UnitIdRange::UNIT_ID_TOTAL]; // The timestep each unit was last added to the changed or generated units in indexed by ID
+    DynamicArray<short> changedUnits; // IDs of the units damaged, healed, infected, moved or destroyed since the last step started
+    DynamicArray<short> generatedUnits; // IDs of the units generated since the last step started
+#endif
+
+    int nextUnitIds[ArmyType::ARMY_TOTAL]; // The ID to give to the next unit generated in each army
+
+    GameStatistics gameStatistics; // Updated as soon as units are generated, destroyed, healed or infected
+
+#ifdef STREAMING_OUTPUT
+    std::ofstream outputFile; // Open during the whole run, killed units are written to it as they're destroyed
+#endif
+
 private:
+    void play(); // Step the loaded battle until it ends or the budget runs out, then finish it
     bool startAttack(); // Makes the two armies attack each other
     void setGameMode(GameMode); // Change the game mode
     bool battleOver(bool) const; // Check if the battle is over
+    bool hasRunOutOfBudget(std::chrono::steady_clock::time_point) const; // Check if the run started at the given time reached a limit of its budget
+    bool isIdle() const; // Check if nothing can attack, be healed or get infected (every army and the UML are empty)
     void killSaverUnits(); // Savers need to be killed once all infected units are healed
 
+#ifndef OUTCOME_ONLY
     void printKilledList() const; // Prints the killed list with the console formats
     void printUnitMaintenanceList() const; // Print the units at the maintence list
-    void printUnitsFighting(); // Print the units fighting in current timestep
+    void logAttack(Unit*, AttackAction, int); // Append the attack to the current timestep's event buffer
+    void groupAttackEvents(BattleLogTimestep&) const; // Fill the timestep's attackers and targets from the attack events
+    void printUnitsFighting() const; // Print the units fighting in current timestep
+    bool isGatheringEvents() const; // Check if a battle log or an observer receives the timestep's events
+    void dispatchTimestepEvents(); // Write the current timestep's events to the battle log and hand them to the observers
+    void dispatchBattleEnd(); // Dispatch the deaths of finishing the battle and the results, then close the battle log
+    void clearAttackEvents(); // Reuse the attack event buffers for the next timestep
     void printAll(); // Prints all the armies and the killed list and units fighting at the current timestep
 
+    bool isBreakpointMet(const Breakpoint&) const; // Evaluate the breakpoint's condition from the counters the game keeps
+    void updatePlayback(); // Check the breakpoints, then stop running or autoplaying at the target timestep, a reached breakpoint or the end of the battle
+    void readCommands(); // Read interactive commands until one continues the battle
+    bool executeCommand(const std::string&); // Execute an interactive command, returns true if it continues the battle
+#endif
+
     std::string battleResult() const; // Returns the result of the battle
     void printFinalResults() const; // Print the final results of the game
 
     void emptyUnitMaintenanceList(); // Empty the unit maintenance list by killing all units in it
+    void freeDestroyedUnits(); // Free the units destroyed during the current timestep
+    void deleteAllUnits(); // Delete the units in the armies, the maintenance list and the destroyed units
+#ifndef OUTCOME_ONLY
+    void clearUnitIndex(); // Mark every ID as not created yet
+    unsigned long long hashUnit(const Unit*, UnitLocation) const; // Hash the unit's ID, location, health and status
+    void writeTrace(std::ostream&) const; // Write the current timestep and state hash as a trace line
+#endif
+    void resetUnitIds(); // Start numbering the units of every army from its first ID
+    void updateUnitIndex(Unit*, UnitLocation); // Record the new location of the unit in the unit index
 
-    GameStatistics countStatistics(); // Calculate the statistics of the game
-    void countArmyStatistics(GameStatistics&, ArmyType, UnitType[], int); // Count the statistics of the given army
-    void countKilledUnitsStatistics(GameStatistics&); // Count the statistics of the killed units
     void generateOutputFile(const std::string&); // Generate the output file with the statistics
+#ifdef STREAMING_OUTPUT
+    void startOutputFile(const std::string&); // Open the output file and write the killed units header
+#endif
 
     bool loadParameters(const std::string&); // Load the parameters from the file and sets parameters in the random generator
 
+    void writeCheckpoint(CheckpointWriter&); // Write the whole state of the battle between two timesteps
+    bool readCheckpoint(CheckpointReader&); // Rebuild the state written by writeCheckpoint on a reset game, returns false if the checkpoint is invalid
+    bool restoreCheckpoint(GameMode, CheckpointReader&, const std::string&); // Reset the game and read the checkpoint, returns false if it's invalid
+    void saveUnitMaintenanceList(CheckpointWriter&); // Write the units of the maintenance list with their priorities in their order
+    bool loadUnitMaintenanceList(CheckpointReader&); // Refill the maintenance list from a checkpoint
+
 public:
     Game();
 
     void run(GameMode, const std::string&, const std::string&); // Run the game
-
+    void resume(GameMode, const std::string&, const std::string&); // Continue the battle saved in the checkpoint file and run it to the end
+    void replay(GameMode, const std::string&, int, const std::string&); // Continue the battle recorded in the replay file from the given timestep and run it to the end
+
+    // Step-wise API, a driver can run many battles on one game object
+    bool load(GameMode, const std::string&, const std::string&); // Load the input file and remember the output file (resets a used game first)
+    StepSummary step(); // Advance the battle by one timestep
+    int skipIdleTimesteps(); // Jump over the coming timesteps where nothing can happen (still traced and dispatched), returns their count
+    bool isOver() const; // Check if the battle is over after the last step
+    bool isTruncated() const; // Check if the last run was stopped by its budget
+    void finish(); // End the battle, write the output file and print the final results
+    void reset(); // Delete all units and clear all lists while keeping the containers' storage
+    void setSeed(unsigned long long); // Seed the game's own random number generator
+    void setRunBudget(const RunBudget&); // Limit the timesteps and time of the next runs
+    void setCheckpoints(int, const std::string&); // Make run write a checkpoint to the given file every given number of timesteps (0 stops them)
+    void setReplay(int, const std::string&); // Make run record a replay to the given file with a keyframe every given number of timesteps (0 stops recording)
+#ifndef OUTCOME_ONLY
+    void setBattleLog(const std::string&); // Make run write a battle log to the given file (an empty name stops logging)
+    void addObserver(BattleObserver*); // Hand the events of every following timestep to the observer
+    void removeObserver(BattleObserver*); // Stop handing events to the observer
+#endif
+
+    // Checkpoints, a resumed battle continues exactly as if it had never stopped
+    bool saveCheckpoint(const std::string&); // Write the battle reached by the last step to the file
+    bool loadCheckpoint(GameMode, const std::string&, const std::string&); // Load the checkpoint file and remember the output file (resets the game first)
+    void saveUnit(CheckpointWriter&, const Unit*) const; // Write the unit's stats, state and lifecycle record
+    Unit* loadUnit(CheckpointReader&, UnitType, UnitLocation); // Recreate a unit of the given type written by saveUnit, returns nullptr if the record is invalid
+    bool seek(GameMode, const std::string&, int, const std::string&); // Load the recorded battle at the given timestep from its nearest keyframe (resets the game first), returns false if the replay is invalid or diverged
+
+    int generateUnitId(ArmyType); // Give the next ID of the given army to a new unit
+    bool cantCreateUnit(ArmyType) const; // Check if the max number of units of the given army is reached
+    void registerUnit(Unit*); // Start the lifecycle record of a newly created unit
     void addUnit(Unit*); // Add a unit to the appropriate army and list
     Unit* removeUnit(ArmyType, UnitType); // Remove a unit from the appropriate army and list
-    LinkedQueue<Unit*> getEnemyList(ArmyType, UnitType, int); // Get the enemy list for the given army type, unit type and attack capacity
-    void registerAttack(Unit*, const std::string&, const std::string&); // Store the current attacker along with its fought units
+    void getEnemyList(ArmyType, UnitType, int, TargetList&); // Fill the caller's target list for the given army type, unit type and attack capacity
+    void registerAttack(Unit*, AttackAction, int); // Store the action the attacker did on the given unit ID
+    void resolveShot(Unit*, Unit*); // The attacker shoots the target
+    bool resolveHeal(Unit*, HealableUnit*); // The healer heals the unit, returns false if the unit waited too long and was killed instead
+    void resolveInfection(Unit*, EarthSoldier*); // The monster infects the soldier
 
     void addToKilledList(Unit*); // Add a unit to the killed list
+    void registerFirstHeal(); // Count a unit healed for the first time in the statistics
+    void registerFirstInfection(); // Count a soldier infected for the first time in the statistics
 
     void addUnitToMaintenanceList(HealableUnit*); // Add a unit to the maintenance list
-    LinkedQueue<HealableUnit*> getUnitsToMaintainList(int); // Get a list of units that need to be maintained
+    void getUnitsToMaintainList(int, HealTargetList&); // Fill the caller's list with units that need to be maintained
+
+    void rehashUnit(Unit*); // Update the state hash of a unit changed in place in its list
+
+#ifndef OUTCOME_ONLY
+    UnitIndexEntry findUnit(int) const; // Find where the unit with the given ID is in O(1)
+    unsigned long long getStateHash() const; // Get the hash of every unit's ID, health, list and infection status
+    void setTraceStream(std::ostream*); // Write the state hash after every timestep to the given stream (nullptr stops the trace)
+    const DynamicArray<short>& getChangedUnits() const; // Get the IDs of the units changed since the last step started, each once in the order they first changed
+    const DynamicArray<short>& getGeneratedUnits() const; // Get the IDs of the units generated since the last step started
+#endif
+
+    // Text formats of the output file and the attack log, shared with the tools rendering a battle log
+    static void writeBattleResults(std::ostream&, const std::string&, int); // Write the battle result and the total timesteps
+#ifndef OUTCOME_ONLY
+    static void writeKilledUnitsHeader(std::ostream&); // Write the title and the header of the killed units table
+    static void writeKilledUnit(std::ostream&, const KilledUnitRecord&); // Write a row of the killed units table
+    static void writeStatistics(std::ostream&, const GameStatistics&); // Write the statistics of the three armies
+    static void writeUnitsFighting(std::ostream&, const BattleLogTimestep&); // Write a line per action of each attacker of the timestep
+#endif
 
     bool doesEarthNeedHelp() const; // Check if the Earth army needs help from the Earth Allied army if the number of infected units exceeds the threshold
+    int getRandomNumber(int, int); // Get a random number in the given range from the game's own generator
+    int getBinomialNumber(int, int); // Get the number of successful trials out of the given count with the given chance percentage
+    bool doTanksAttackSoldiers(); // Check if the earth tanks will attack alien soldiers in the current timestep
 
     // Getters
     int getCurrentTimestep() const;
     int getUnitsCount(ArmyType, UnitType) const;
     int getInfectedUnitsCount() const;
+    int getInfectingProbability() const; // Get the alien monsters' infecting probability
+    const GameStatistics& getStatistics() const; // Get the statistics of the game so far
+    UnitLifecycle& getUnitLifecycle(int); // Get the lifecycle record of the unit with the given ID
+    const UnitLifecycle& getUnitLifecycle(int) const;
 
     ~Game();
 };
 
+#ifdef OUTCOME_ONLY
+// Only the winner and the battle length are kept, so the bookkeeping hooks compile to nothing at their call sites
+inline void Game::registerAttack(Unit*, AttackAction, int)
+{}
+
+inline void Game::registerFirstHeal()
+{}
+
+inline void Game::registerFirstInfection()
+{}
+
+inline void Game::updateUnitIndex(Unit*, UnitLocation)
+{}
+
+inline void Game::rehashUnit(Unit*)
+{}
+#else
+inline void Game::registerAttack(Unit* attacker, AttackAction action, int targetId)
+{
+    // The attack bookkeeping costs nothing but this check when the log is never printed
+    if (isAttackLogEnabled)
+        logAttack(attacker, action, targetId);
+}
+#endif
+
 #endif
\ No newline at end of file
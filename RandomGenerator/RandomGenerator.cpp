@@ -1,3 +1,5 @@
+#include <cmath>
+
 #include "RandomGenerator.h"
 #include "../UnitClasses/Unit.h"
 #include "../UnitClasses/EarthSoldier.h"
@@ -10,7 +12,58 @@
 #include "../UnitClasses/SaverUnit.h"
 #include "../Game.h"
 
-RandomGenerator::RandomGenerator(Game* gamePtr): gamePtr(gamePtr), isGeneratingSavers(false)
+RandomStream::RandomStream(unsigned long long seed): state(seed)
+{}
+
+unsigned long long RandomStream::nextRandom()
+{
+	state += 0x9E3779B97F4A7C15ULL;
+
+	unsigned long long z = state;
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+	return z ^ (z >> 31);
+}
+
+int RandomStream::getRandomNumber(int min, int max)
+{
+	// A non-negative 31-bit value like rand() gives, so ranges behave as they did with rand()
+	int randomValue = (int) (nextRandom() >> 33);
+
+	return min + randomValue % (max - min + 1);
+}
+
+int RandomStream::getBinomialNumber(int trials, int chancePercentage)
+{
+	if (chancePercentage <= 0)
+		return 0;
+
+	if (chancePercentage >= 100)
+		return trials;
+
+	// Jump over the failed trials with geometric gaps, so the cost is proportional to the successes instead of the trials
+	double logFailChance = std::log(1 - chancePercentage / 100.0);
+	int successes = 0;
+	int trial = -1;
+
+	while (true)
+	{
+		double fraction = ((nextRandom() >> 11) + 1) / 9007199254740992.0; // Uniform in (0, 1]
+		trial += 1 + (int) (std::log(fraction) / logFailChance);
+
+		if (trial >= trials)
+			return successes;
+
+		successes++;
+	}
+}
+
+unsigned long long RandomStream::getState() const
+{
+	return state;
+}
+
+RandomGenerator::RandomGenerator(Game* gamePtr): gamePtr(gamePtr), isGeneratingSavers(false), randomStream(0)
 {
 	// Initialize the parameters with default values
 	setN(0);
@@ -24,83 +77,145 @@ void RandomGenerator::generateUnits()
 {
 	ArmyType armyTypes[3] = { ArmyType::EARTH, ArmyType::ALIEN, ArmyType::EARTH_ALLIED };
 
+	// Decide which armies get units
+	bool isGenerating[3];
+	rollArmiesToGenerate(isGenerating);
+
 	for (int i = 0; i < 3; i++)
 	{
-		int A = getRandomNumber(1, 100);
+		if (!isGenerating[i])
+			continue;
 
-		if (A <= prob) // If the probability is satisfied, generate the units
-		{
-			Unit* newUnit = nullptr;
+		Unit* newUnit = nullptr;
 
-			// Generate N units
-			for (int j = 0; j < N; j++)
-			{
-				// Don't forget to handle no generation in allied army
-				newUnit = generateUnit(armyTypes[i]);
+		// Generate N units
+		for (int j = 0; j < N; j++)
+		{
+			// Don't forget to handle no generation in allied army
+			newUnit = generateUnit(armyTypes[i], rollUnitSpec(armyTypes[i]));
 
-				if (newUnit) // Unit may be nullptr if the max number of units is reached
-					gamePtr->addUnit(newUnit); // Add the unit to the suitable army & list based on the unit type
-			}
+			if (newUnit) // Unit may be nullptr if the max number of units is reached
+				gamePtr->addUnit(newUnit); // Add the unit to the suitable army & list based on the unit type
 		}
 	}
 }
 
-Unit* RandomGenerator::generateUnit(ArmyType armyType)
+bool RandomGenerator::rollArmiesToGenerate(bool isGenerating[])
 {
-	Unit* newUnit = nullptr;
+	bool isAnyGenerating = false;
 
-	int B = getRandomNumber(1, 100);
+	for (int i = 0; i < 3; i++)
+	{
+		int A = getRandomNumber(1, 100);
+		isGenerating[i] = A <= prob; // If the probability is satisfied, generate the units
+		isAnyGenerating = isAnyGenerating || isGenerating[i];
+	}
 
-	if (armyType == ArmyType::EARTH)
+	return isAnyGenerating;
+}
+
+bool RandomGenerator::skipIdleTimestep()
+{
+	RandomStream timestepStart = randomStream;
+
+	// Leave the rolls to generateUnits if any army gets units in this timestep
+	bool isGenerating[3];
+	if (rollArmiesToGenerate(isGenerating))
 	{
-		// Check if the max number of earth units is reached
-		if (Unit::cantCreateEarthUnit())
-			return nullptr;
+		randomStream = timestepStart;
+		return false;
+	}
+
+	return true;
+}
+
+UnitSpec RandomGenerator::rollUnitSpec(ArmyType armyType)
+{
+	UnitSpec unitSpec = { UnitType::SU, 0, 0, 0 };
+
+	int B = randomStream.getRandomNumber(1, 100);
 
-		int power = getRandomNumber(earthPowerRange.min, earthPowerRange.max);
-		int health = getRandomNumber(earthHealthRange.min, earthHealthRange.max);
-		int attackCapacity = getRandomNumber(earthAttackCapacityRange.min, earthAttackCapacityRange.max);
+	if (armyType == ArmyType::EARTH)
+	{
+		unitSpec.power = randomStream.getRandomNumber(earthPowerRange.min, earthPowerRange.max);
+		unitSpec.health = randomStream.getRandomNumber(earthHealthRange.min, earthHealthRange.max);
+		unitSpec.attackCapacity = randomStream.getRandomNumber(earthAttackCapacityRange.min, earthAttackCapacityRange.max);
 
 		if (B <= ESPercentage)
-			newUnit = new EarthSoldier(gamePtr, health, power, attackCapacity);
+			unitSpec.unitType = UnitType::ES;
 		else if (B <= (ESPercentage + ETPercentage))
-			newUnit = new EarthTank(gamePtr, health, power, attackCapacity);
+			unitSpec.unitType = UnitType::ET;
 		else if (B <= (ESPercentage + ETPercentage + EGPercentage))
-			newUnit = new EarthGunnery(gamePtr, health, power, attackCapacity);
+			unitSpec.unitType = UnitType::EG;
 		else
-			newUnit = new HealUnit(gamePtr, health, power, attackCapacity);
+			unitSpec.unitType = UnitType::EH;
 	}
 	else if (armyType == ArmyType::ALIEN)
 	{
-		// Check if the max number of alien units is reached
-		if (Unit::cantCreateAlienUnit())
-			return nullptr;
-
-		int power = getRandomNumber(alienPowerRange.min, alienPowerRange.max);
-		int health = getRandomNumber(alienHealthRange.min, alienHealthRange.max);
-		int attackCapacity = getRandomNumber(alienAttackCapacityRange.min, alienAttackCapacityRange.max);
+		unitSpec.power = randomStream.getRandomNumber(alienPowerRange.min, alienPowerRange.max);
+		unitSpec.health = randomStream.getRandomNumber(alienHealthRange.min, alienHealthRange.max);
+		unitSpec.attackCapacity = randomStream.getRandomNumber(alienAttackCapacityRange.min, alienAttackCapacityRange.max);
 
 		if (B <= ASPercentage)
-			newUnit = new AlienSoldier(gamePtr, health, power, attackCapacity);
+			unitSpec.unitType = UnitType::AS;
 		else if (B <= (ASPercentage + AMPercentage))
-			newUnit = new AlienMonster(gamePtr, health, power, attackCapacity);
+			unitSpec.unitType = UnitType::AM;
 		else
-			newUnit = new AlienDrone(gamePtr, health, power, attackCapacity);
+			unitSpec.unitType = UnitType::AD;
 	}
-	else if (armyType == ArmyType::EARTH_ALLIED && willGenerateSavers())
+	else
 	{
-		// Check if the max number of allied units is reached
-		if (Unit::cantCreateEarthAlliedUnit())
-			return nullptr;
+		unitSpec.power = randomStream.getRandomNumber(earthAlliedPowerRange.min, alienPowerRange.max);
+		unitSpec.health = randomStream.getRandomNumber(earthAlliedHealthRange.min, earthAlliedHealthRange.max);
+		unitSpec.attackCapacity = randomStream.getRandomNumber(earthAlliedAttackCapacityRange.min, earthAlliedAttackCapacityRange.max);
+	}
 
-		int power = getRandomNumber(earthAlliedPowerRange.min, alienPowerRange.max);
-		int health = getRandomNumber(earthAlliedHealthRange.min, earthAlliedHealthRange.max);
-		int attackCapacity = getRandomNumber(earthAlliedAttackCapacityRange.min, earthAlliedAttackCapacityRange.max);
+	return unitSpec;
+}
 
-		newUnit = new SaverUnit(gamePtr, health, power, attackCapacity);
+Unit* RandomGenerator::generateUnit(ArmyType armyType, const UnitSpec& unitSpec)
+{
+	// Savers are only generated while the earth army needs help
+	if (armyType == ArmyType::EARTH_ALLIED && !willGenerateSavers())
+		return nullptr;
+
+	// Check if the max number of units of the army is reached
+	if (gamePtr->cantCreateUnit(armyType))
+		return nullptr;
+
+	return createUnit(unitSpec);
+}
+
+Unit* RandomGenerator::createUnit(const UnitSpec& unitSpec)
+{
+	switch (unitSpec.unitType)
+	{
+		case UnitType::ES:
+			return new EarthSoldier(gamePtr, unitSpec.health, unitSpec.power, unitSpec.attackCapacity);
+
+		case UnitType::ET:
+			return new EarthTank(gamePtr, unitSpec.health, unitSpec.power, unitSpec.attackCapacity);
+
+		case UnitType::EG:
+			return new EarthGunnery(gamePtr, unitSpec.health, unitSpec.power, unitSpec.attackCapacity);
+
+		case UnitType::EH:
+			return new HealUnit(gamePtr, unitSpec.health, unitSpec.power, unitSpec.attackCapacity);
+
+		case UnitType::AS:
+			return new AlienSoldier(gamePtr, unitSpec.health, unitSpec.power, unitSpec.attackCapacity);
+
+		case UnitType::AM:
+			return new AlienMonster(gamePtr, unitSpec.health, unitSpec.power, unitSpec.attackCapacity);
+
+		case UnitType::AD:
+			return new AlienDrone(gamePtr, unitSpec.health, unitSpec.power, unitSpec.attackCapacity);
+
+		case UnitType::SU:
+			return new SaverUnit(gamePtr, unitSpec.health, unitSpec.power, unitSpec.attackCapacity);
 	}
 
-	return newUnit;
+	return nullptr;
 }
 
 bool RandomGenerator::willGenerateSavers()
@@ -113,9 +228,60 @@ bool RandomGenerator::willGenerateSavers()
 	return isGeneratingSavers;
 }
 
-int RandomGenerator::getRandomNumber(int min, int max) const
+int RandomGenerator::getRandomNumber(int min, int max)
+{
+	return randomStream.getRandomNumber(min, max);
+}
+
+int RandomGenerator::getBinomialNumber(int trials, int chancePercentage)
+{
+	return randomStream.getBinomialNumber(trials, chancePercentage);
+}
+
+void RandomGenerator::reset()
+{
+	isGeneratingSavers = false;
+}
+
+void RandomGenerator::saveState(CheckpointWriter& writer) const
+{
+	writer.writeInteger(randomStream.getState(), 8);
+	writer.writeBool(isGeneratingSavers);
+
+	const int parameters[9] = { N, prob, ESPercentage, ETPercentage, EGPercentage, EHPercentage, ASPercentage, AMPercentage, ADPercentage };
+	for (int i = 0; i < 9; i++)
+		writer.writeInteger(parameters[i], 4);
+
+	const Range ranges[9] = { earthPowerRange, earthHealthRange, earthAttackCapacityRange, alienPowerRange, alienHealthRange, alienAttackCapacityRange,
+		earthAlliedPowerRange, earthAlliedHealthRange, earthAlliedAttackCapacityRange };
+	for (int i = 0; i < 9; i++)
+	{
+		writer.writeInteger(ranges[i].min, 4);
+		writer.writeInteger(ranges[i].max, 4);
+	}
+}
+
+void RandomGenerator::loadState(CheckpointReader& reader)
+{
+	randomStream = RandomStream(reader.readInteger(8));
+	isGeneratingSavers = reader.readBool();
+
+	int* parameters[9] = { &N, &prob, &ESPercentage, &ETPercentage, &EGPercentage, &EHPercentage, &ASPercentage, &AMPercentage, &ADPercentage };
+	for (int i = 0; i < 9; i++)
+		*parameters[i] = (int) reader.readInteger(4);
+
+	Range* ranges[9] = { &earthPowerRange, &earthHealthRange, &earthAttackCapacityRange, &alienPowerRange, &alienHealthRange, &alienAttackCapacityRange,
+		&earthAlliedPowerRange, &earthAlliedHealthRange, &earthAlliedAttackCapacityRange };
+	for (int i = 0; i < 9; i++)
+	{
+		ranges[i]->min = (int) reader.readInteger(4);
+		ranges[i]->max = (int) reader.readInteger(4);
+	}
+}
+
+void RandomGenerator::setSeed(unsigned long long seed)
 {
-	return min + rand() % (max - min + 1);
+	randomStream = RandomStream(seed);
 }
 
 void RandomGenerator::setN(int N)
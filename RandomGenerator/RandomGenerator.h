@@ -2,15 +2,34 @@
 #define RANDOM_GENERATOR_H
 
 #include "../DEFS.h"
+#include "../Checkpoint/Checkpoint.h"
 #include "../UnitClasses/Unit.h"
 
 class Game;
 
+// A splitmix64 random number sequence
+class RandomStream
+{
+private:
+	unsigned long long state;
+
+public:
+	RandomStream(unsigned long long = 0);
+
+	unsigned long long nextRandom(); // Advance the random number sequence
+	int getRandomNumber(int, int); // Generate a random number between the given range
+	int getBinomialNumber(int, int); // Count the successes of the given number of trials with the given chance percentage
+
+	// Getters
+	unsigned long long getState() const; // Get the position in the sequence, a stream constructed from it continues the sequence
+};
+
 class RandomGenerator
 {
 private:
 	Game* gamePtr;
 	bool isGeneratingSavers;
+	RandomStream randomStream; // The game's own random number sequence (not shared with other games)
 
 	int N;
 	int ESPercentage;
@@ -33,16 +52,26 @@ private:
 	Range earthAlliedAttackCapacityRange;
 
 private:
-	Unit* generateUnit(ArmyType); // Generate a unit of the given army type
+	bool rollArmiesToGenerate(bool[]); // Roll which armies get units in the current timestep, returns false if none of them does
+	UnitSpec rollUnitSpec(ArmyType); // Roll the type and stats of a unit of the given army type
+	Unit* generateUnit(ArmyType, const UnitSpec&); // Generate a unit of the given army type with the rolled stats
 	bool willGenerateSavers(); // A check to determine the need of generating savers
 
 public:
 	RandomGenerator(Game*);
 
 	void generateUnits(); // Generate units for the both armies
-	int getRandomNumber(int, int) const; // Generate a random number between the given range
+	bool skipIdleTimestep(); // Draw the rolls of a timestep where no army gets units, returns false without drawing if one does
+	int getRandomNumber(int, int); // Generate a random number between the given range
+	int getBinomialNumber(int, int); // Count the successes of the given number of trials with the given chance percentage
+	Unit* createUnit(const UnitSpec&); // Create a unit of the spec's type with its stats
+	void reset(); // Forget the generation state of a previous battle
+
+	void saveState(CheckpointWriter&) const; // Write the parameters and the position in the random number sequence
+	void loadState(CheckpointReader&); // Continue from the parameters and the position written in a checkpoint
 
 	// Setters
+	void setSeed(unsigned long long); // Start the random number sequence from the given seed
 	void setN(int); // Set the number of units to generate
 	void setProb(int); // Set the probability of generating a unit
 
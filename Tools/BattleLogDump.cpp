@@ -0,0 +1,77 @@
+#include <iostream>
+#include <fstream>
+#include <string>
+
+#include "../Game.h"
+
+// Renders a battle log in the game's text formats: the units fighting at every timestep and the output file
+// Usage: BattleLogDump <battle log> [output file]
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2)
+    {
+        std::cout << "Usage: BattleLogDump <battle log> [output file]" << std::endl;
+        return 2;
+    }
+
+    BattleLogReader reader;
+    if (!reader.open(argv[1]))
+    {
+        std::cout << "Error: Invalid battle log file!" << std::endl;
+        return 1;
+    }
+
+    BattleLogTimestep timestep;
+    DynamicArray<KilledUnitRecord> killedList;
+    KilledUnitRecord killedUnit = { 0 };
+    int printedTimestep = 0;
+
+    while (reader.readTimestep(timestep))
+    {
+        // The deaths of finishing the battle come in a second block of the last timestep
+        if (timestep.timestep != printedTimestep)
+        {
+            std::cout << std::endl;
+            std::cout << "Current Timestep " << timestep.timestep << std::endl;
+            std::cout << (timestep.attackers.isEmpty() ? "============== No units fighting at current step ==============" : "============== Units fighting at current step =================") << std::endl;
+            Game::writeUnitsFighting(std::cout, timestep);
+
+            printedTimestep = timestep.timestep;
+        }
+
+        for (int i = 0; i < timestep.deaths.getCount(); i++)
+        {
+            timestep.deaths.entryAt(killedUnit, i);
+            killedList.insert(killedUnit);
+        }
+    }
+
+    BattleLogSummary summary;
+    if (!reader.isValid() || !reader.readSummary(summary))
+    {
+        std::cout << "Error: Invalid battle log file!" << std::endl;
+        return 1;
+    }
+
+    // The output file as the game writes it
+    if (argc > 2)
+    {
+        std::ofstream fout(argv[2]);
+
+        Game::writeBattleResults(fout, summary.battleResult, summary.totalTimesteps);
+
+        fout << std::endl;
+        Game::writeKilledUnitsHeader(fout);
+
+        for (int i = 0; i < killedList.getCount(); i++)
+        {
+            killedList.entryAt(killedUnit, i);
+            Game::writeKilledUnit(fout, killedUnit);
+        }
+
+        Game::writeStatistics(fout, summary.statistics);
+    }
+
+    return 0;
+}
\ No newline at end of file
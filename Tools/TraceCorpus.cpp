@@ -0,0 +1,188 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "../Game.h"
+
+// Records the state hash traces of seeded runs of every input file, or checks a build against the recorded ones
+// Run it from the repository root: TraceCorpus record|verify [corpus directory]
+
+const int SEEDS_COUNT = 3;
+const int INPUT_FILES_COUNT = 6;
+const std::string inputFiles[INPUT_FILES_COUNT] = { "strong_earth_strong_aliens", "strong_earth_moderate_aliens", "strong_earth_weak_aliens",
+                                                   "weak_earth_weak_aliens", "weak_earth_moderate_aliens", "weak_earth_strong_aliens" };
+
+std::string traceBattle(Game*, const std::string&, int, bool); // Run a seeded battle step by step, optionally skipping idle timesteps as a silent run does, and return its trace
+bool readFile(const std::string&, std::string&); // Read the whole file into the string
+void reportFirstDifference(const std::string&, const std::string&, const std::string&); // Print the first trace line that differs
+bool checkHealthChangesHash(Game*); // Check that changing only a unit's health changes the state hash
+
+int main(int argc, char* argv[])
+{
+    std::string mode = argc > 1 ? argv[1] : "";
+    std::string corpusDirectory = argc > 2 ? argv[2] : "GoldenTraces";
+
+    if (mode != "record" && mode != "verify")
+    {
+        std::cout << "Usage: TraceCorpus record|verify [corpus directory]" << std::endl;
+        return 2;
+    }
+
+    // Made on the heap since the game object is large
+    Game* game = new Game;
+    int mismatchesCount = 0;
+
+    for (int i = 0; i < INPUT_FILES_COUNT; i++)
+    {
+        for (int seed = 1; seed <= SEEDS_COUNT; seed++)
+        {
+            std::string trace = traceBattle(game, "InputFiles/" + inputFiles[i] + ".txt", seed, false);
+            std::string traceFileName = corpusDirectory + "/" + inputFiles[i] + "_seed" + std::to_string(seed) + ".trace";
+
+            if (mode == "record")
+            {
+                std::ofstream traceFile(traceFileName, std::ios::binary);
+                traceFile << trace;
+                continue;
+            }
+
+            std::string goldenTrace;
+            if (!readFile(traceFileName, goldenTrace))
+            {
+                std::cout << traceFileName << ": missing" << std::endl;
+                mismatchesCount++;
+            }
+            else if (trace != goldenTrace)
+            {
+                reportFirstDifference(traceFileName, goldenTrace, trace);
+                mismatchesCount++;
+            }
+
+            // Skipped idle timesteps still write their trace lines
+            std::string skippingTrace = traceBattle(game, "InputFiles/" + inputFiles[i] + ".txt", seed, true);
+            if (skippingTrace != trace)
+            {
+                reportFirstDifference(traceFileName + " (skipping idle timesteps)", trace, skippingTrace);
+                mismatchesCount++;
+            }
+        }
+    }
+
+    // A trace can only catch a wrong health if the health is part of the hash
+    if (mode == "verify" && !checkHealthChangesHash(game))
+    {
+        std::cout << "A health change doesn't change the state hash" << std::endl;
+        mismatchesCount++;
+    }
+
+    delete game;
+
+    if (mode == "verify")
+        std::cout << (mismatchesCount == 0 ? "All traces match" : std::to_string(mismatchesCount) + " traces differ") << std::endl;
+
+    return mismatchesCount == 0 ? 0 : 1;
+}
+
+std::string traceBattle(Game* game, const std::string& inputFileName, int seed, bool isSkippingIdleTimesteps)
+{
+    std::ostringstream trace;
+
+    game->setSeed(seed);
+    game->setTraceStream(&trace);
+
+    // Every timestep has a trace line, a skipped one as well as a stepped one
+    if (game->load(GameMode::SILENT, inputFileName, ""))
+    {
+        do
+        {
+            if (isSkippingIdleTimesteps)
+                game->skipIdleTimesteps();
+
+            game->step();
+        }
+        while (!game->isOver());
+    }
+
+    game->setTraceStream(nullptr);
+
+    return trace.str();
+}
+
+bool readFile(const std::string& fileName, std::string& content)
+{
+    std::ifstream file(fileName, std::ios::binary);
+    if (!file.is_open())
+        return false;
+
+    std::ostringstream stream;
+    stream << file.rdbuf();
+    content = stream.str();
+
+    return true;
+}
+
+void reportFirstDifference(const std::string& traceFileName, const std::string& goldenTrace, const std::string& trace)
+{
+    std::istringstream goldenLines(goldenTrace);
+    std::istringstream lines(trace);
+    std::string goldenLine;
+    std::string line;
+
+    while (true)
+    {
+        bool hasGoldenLine = (bool) std::getline(goldenLines, goldenLine);
+        bool hasLine = (bool) std::getline(lines, line);
+
+        if (!hasGoldenLine || !hasLine || goldenLine != line)
+        {
+            std::cout << traceFileName << ": expected \"" << (hasGoldenLine ? goldenLine : "end of battle") << "\", got \"" << (hasLine ? line : "end of battle") << "\"" << std::endl;
+            return;
+        }
+    }
+}
+
+bool checkHealthChangesHash(Game* game)
+{
+    game->setSeed(1);
+    if (!game->load(GameMode::SILENT, "InputFiles/" + inputFiles[0] + ".txt", ""))
+        return false;
+
+    // Step the battle until its first Earth unit exists
+    UnitIndexEntry entry = game->findUnit(UnitIdRange::EARTH_FIRST_ID);
+    while (!entry.unitPtr && !game->isOver())
+    {
+        game->step();
+        entry = game->findUnit(UnitIdRange::EARTH_FIRST_ID);
+    }
+
+    if (!entry.unitPtr)
+        return false;
+
+    Unit* unit = entry.unitPtr;
+    HealthValue health = unit->getHealth();
+    unsigned long long stateHash = game->getStateHash();
+    HealthValue previousHealth = health;
+    unsigned long long previousHash = stateHash;
+    bool isHashChanged = true;
+
+    // Each whole health gives another hash than the health before it, only the health differs
+    for (int i = 1; i <= 100 && isHashChanged; i++)
+    {
+        if (healthFromInt(i) == previousHealth)
+            continue;
+
+        unit->restoreState(healthFromInt(i), unit->getStatusFlags());
+        game->rehashUnit(unit);
+        isHashChanged = game->getStateHash() != previousHash;
+
+        previousHealth = healthFromInt(i);
+        previousHash = game->getStateHash();
+    }
+
+    // Putting the health back gives the hash back
+    unit->restoreState(health, unit->getStatusFlags());
+    game->rehashUnit(unit);
+
+    return isHashChanged && game->getStateHash() == stateHash;
+}
\ No newline at end of file
@@ -1,15 +1,10 @@
 #include "AlienDrone.h"
 #include "../Game.h"
 
-AlienDrone::AlienDrone(Game* gamePtr, double health, int power, int attackCapacity)
+AlienDrone::AlienDrone(Game* gamePtr, int health, int power, int attackCapacity)
     : Unit(gamePtr, UnitType::AD, health, power, attackCapacity)
 {}
 
-void AlienDrone::printUnit()
-{
-    std::cout << "AD " << id;
-}
-
 bool AlienDrone::attack()
 {
     // Attack capacity is divided 50:50 between them
@@ -17,10 +12,10 @@ bool AlienDrone::attack()
     int EGnumber = attackCapacity - ETnumber;
 
     // Get the lists of units to attack
-    LinkedQueue<Unit*> ETlist = gamePtr->getEnemyList(ArmyType::EARTH, UnitType::ET, ETnumber);
-    LinkedQueue<Unit*> EGlist = gamePtr->getEnemyList(ArmyType::EARTH, UnitType::EG, EGnumber);
-
-    std::string foughtUnits = "";
+    TargetList ETlist;
+    TargetList EGlist;
+    gamePtr->getEnemyList(ArmyType::EARTH, UnitType::ET, ETnumber, ETlist);
+    gamePtr->getEnemyList(ArmyType::EARTH, UnitType::EG, EGnumber, EGlist);
 
     // Check for a successful attack
     bool attackCheck = false;
@@ -30,21 +25,8 @@ bool AlienDrone::attack()
 
     while (ETlist.dequeue(enemyUnit) || EGlist.dequeue(enemyUnit))
     {
-        // Calculate the UAP and apply the damage
-        enemyUnit->receiveDamage(calcUAP(enemyUnit));
-
-        // Check if the unit is dead, needs healing or can join the battle
-        if (enemyUnit->isDead())
-            gamePtr->addToKilledList(enemyUnit);
-        else if (enemyUnit->needsHeal())
-            gamePtr->addUnitToMaintenanceList(dynamic_cast<HealableUnit*>(enemyUnit));
-        else
-            gamePtr->addUnit(enemyUnit);
-
-        // Store the IDs of the fought units to be printed later
-        if (foughtUnits != "")
-            foughtUnits += ", ";
-        foughtUnits += std::to_string(enemyUnit->getId());
+        // Damage the unit and send it to the list it belongs to
+        gamePtr->resolveShot(this, enemyUnit);
 
         // Nullify the pointer
         enemyUnit = nullptr;
@@ -53,8 +35,5 @@ bool AlienDrone::attack()
         attackCheck = true;
     }
 
-    if (foughtUnits != "")
-        gamePtr->registerAttack(this, "shots", foughtUnits);
-
     return attackCheck;
 }
\ No newline at end of file
@@ -7,9 +7,8 @@
 class AlienDrone: public Unit
 {
 public:
-	AlienDrone(Game*, double, int, int);
+	AlienDrone(Game*, int, int, int);
 
-	void printUnit(); // Print the unit's type along with its ID
 	bool attack(); // Attack the enemy units
 };
 
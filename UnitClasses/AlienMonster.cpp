@@ -1,22 +1,10 @@
 #include "AlienMonster.h"
 #include "../Game.h"
 
-int AlienMonster::infectingProbability = 0;
-
-AlienMonster::AlienMonster(Game* gamePtr, double health, int power, int attackCapacity)
+AlienMonster::AlienMonster(Game* gamePtr, int health, int power, int attackCapacity)
     : Unit(gamePtr, UnitType::AM, health, power, attackCapacity)
 {}
 
-void AlienMonster::setInfectingProbability(int probability)
-{
-    infectingProbability = probability;
-}
-
-void AlienMonster::printUnit()
-{
-    std::cout << "AM " << id;
-}
-
 bool AlienMonster::attack()
 {
     // Calculate the number of soldiers and tanks to attack
@@ -25,11 +13,12 @@ bool AlienMonster::attack()
     int saversCapacity = attackCapacity - soldiersCapacity - tanksCapacity;
 
     // Get the lists of earth soldiers and tanks to attack
-    LinkedQueue<Unit*> soldiersList = gamePtr->getEnemyList(ArmyType::EARTH, UnitType::ES, soldiersCapacity);
-    LinkedQueue<Unit*> tanksList = gamePtr->getEnemyList(ArmyType::EARTH, UnitType::ET, tanksCapacity);
-    LinkedQueue<Unit*> saversList = gamePtr->getEnemyList(ArmyType::EARTH_ALLIED, UnitType::SU, saversCapacity);
-
-    std::string foughtUnits = "", infectedSoldiers = "";
+    TargetList soldiersList;
+    TargetList tanksList;
+    TargetList saversList;
+    gamePtr->getEnemyList(ArmyType::EARTH, UnitType::ES, soldiersCapacity, soldiersList);
+    gamePtr->getEnemyList(ArmyType::EARTH, UnitType::ET, tanksCapacity, tanksList);
+    gamePtr->getEnemyList(ArmyType::EARTH_ALLIED, UnitType::SU, saversCapacity, saversList);
 
     // Check for a successful attack
     bool attackCheck = false;
@@ -41,35 +30,17 @@ bool AlienMonster::attack()
     while (soldiersList.dequeue(enemyUnit) || tanksList.dequeue(enemyUnit) || saversList.dequeue(enemyUnit))
     {
         // Check if the enemy unit is an Earth Soldier and infect it if the probability is met
-        int x = rand() % 100 + 1;
-        if (enemyUnit->getUnitType() == UnitType::ES && x <= infectingProbability)
+        int x = gamePtr->getRandomNumber(1, 100);
+        if (enemyUnit->getUnitType() == UnitType::ES && x <= gamePtr->getInfectingProbability())
         {
-            dynamic_cast<EarthSoldier*>(enemyUnit)->getInfection(); // The soldier will get infected if not infected already and not immune
-            gamePtr->addUnit(enemyUnit); // The soldier will be re-enqueued to the list & infected soldiers counter will be incremented
-
-            // Store the IDs of the fought units to be printed later
-            if (infectedSoldiers != "")
-                infectedSoldiers += ", ";
-            infectedSoldiers += std::to_string(enemyUnit->getId());
+            // The soldier gets infected if not infected already and not immune, then returns to its list
+            gamePtr->resolveInfection(this, static_cast<EarthSoldier*>(enemyUnit));
 
             continue;
         }
 
-        // Calculate the UAP and apply the damage
-        enemyUnit->receiveDamage(calcUAP(enemyUnit));
-
-        // Check if the unit is dead, needs healing or can join the battle
-        if (enemyUnit->isDead())
-            gamePtr->addToKilledList(enemyUnit);
-        else if (enemyUnit->needsHeal())
-            gamePtr->addUnitToMaintenanceList(dynamic_cast<HealableUnit*>(enemyUnit));
-        else
-            gamePtr->addUnit(enemyUnit);
-
-        // Store the IDs of the fought units to be printed later
-        if (foughtUnits != "")
-            foughtUnits += ", ";
-        foughtUnits += std::to_string(enemyUnit->getId());
+        // Damage the unit and send it to the list it belongs to
+        gamePtr->resolveShot(this, enemyUnit);
 
         // Nullify the pointer
         enemyUnit = nullptr;
@@ -78,10 +49,5 @@ bool AlienMonster::attack()
         attackCheck = true;
     }
 
-    if (foughtUnits != "")
-        gamePtr->registerAttack(this, "shots", foughtUnits);
-    if (infectedSoldiers != "")
-        gamePtr->registerAttack(this, "infects", infectedSoldiers);
-
     return attackCheck;
 }
\ No newline at end of file
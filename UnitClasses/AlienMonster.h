@@ -6,16 +6,9 @@
 
 class AlienMonster: public Unit
 {
-private:
-	static int infectingProbability; // The probability of infecting the enemy units
-
 public:
-	AlienMonster(Game*, double, int, int);
-
-	// Static functions
-	static void setInfectingProbability(int); // Set the infecting probability
+	AlienMonster(Game*, int, int, int);
 
-	void printUnit(); // Print the unit's type along with its ID
 	bool attack(); // Attack the enemy units
 };
 
@@ -1,15 +1,10 @@
 #include "AlienSoldier.h"
 #include "../Game.h"
 
-AlienSoldier::AlienSoldier(Game* gamePtr, double health, int power, int attackCapacity)
+AlienSoldier::AlienSoldier(Game* gamePtr, int health, int power, int attackCapacity)
     : Unit(gamePtr, UnitType::AS, health, power, attackCapacity)
 {}
 
-void AlienSoldier::printUnit()
-{
-    std::cout << "AS " << id;
-}
-
 bool AlienSoldier::attack()
 {
     // Calculate the number of earth soldiers and saver units to attack
@@ -17,10 +12,10 @@ bool AlienSoldier::attack()
     int saversCapacity = attackCapacity - soldiersCapacity;
 
     // Get the lists of earth soldiers and saver units to attack
-    LinkedQueue<Unit*> soldiersList = gamePtr->getEnemyList(ArmyType::EARTH, UnitType::ES, soldiersCapacity);
-    LinkedQueue<Unit*> saversList = gamePtr->getEnemyList(ArmyType::EARTH_ALLIED, UnitType::SU, saversCapacity);
-
-    std::string foughtUnits = "";
+    TargetList soldiersList;
+    TargetList saversList;
+    gamePtr->getEnemyList(ArmyType::EARTH, UnitType::ES, soldiersCapacity, soldiersList);
+    gamePtr->getEnemyList(ArmyType::EARTH_ALLIED, UnitType::SU, saversCapacity, saversList);
 
     // Check for a successful attack
     bool attackCheck = false;
@@ -30,21 +25,8 @@ bool AlienSoldier::attack()
 
     while (soldiersList.dequeue(enemyUnit) || saversList.dequeue(enemyUnit))
     {
-        // Calculate the UAP and apply the damage
-        enemyUnit->receiveDamage(calcUAP(enemyUnit));
-
-        // Check if the unit is dead, needs healing or can join the battle
-        if (enemyUnit->isDead())
-            gamePtr->addToKilledList(enemyUnit);
-        else if (enemyUnit->needsHeal())
-            gamePtr->addUnitToMaintenanceList(dynamic_cast<HealableUnit*>(enemyUnit));
-        else
-            gamePtr->addUnit(enemyUnit);
-
-        // Store the IDs of the fought units to be printed later
-        if (foughtUnits != "")
-            foughtUnits += ", ";
-        foughtUnits += std::to_string(enemyUnit->getId());
+        // Damage the unit and send it to the list it belongs to
+        gamePtr->resolveShot(this, enemyUnit);
 
         // Nullify the pointer
         enemyUnit = nullptr;
@@ -53,8 +35,5 @@ bool AlienSoldier::attack()
         attackCheck = true;
     }
 
-    if (foughtUnits != "")
-        gamePtr->registerAttack(this, "shots", foughtUnits);
-
     return attackCheck;
 }
\ No newline at end of file
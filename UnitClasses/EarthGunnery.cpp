@@ -1,15 +1,10 @@
 #include "EarthGunnery.h"
 #include "../Game.h"
 
-EarthGunnery::EarthGunnery(Game* gamePtr, double health, int power, int attackCapacity)
+EarthGunnery::EarthGunnery(Game* gamePtr, int health, int power, int attackCapacity)
     : Unit(gamePtr, UnitType::EG, health, power, attackCapacity)
 {}
 
-void EarthGunnery::printUnit()
-{
-    std::cout << "EG " << id;
-}
-
 bool EarthGunnery::attack()
 {
     int dronesCapacity = attackCapacity / 2;
@@ -19,10 +14,10 @@ bool EarthGunnery::attack()
 
     int monstersCapacity = attackCapacity - dronesCapacity;
 
-    LinkedQueue<Unit*> dronesList = gamePtr->getEnemyList(ArmyType::ALIEN, UnitType::AD, dronesCapacity);
-    LinkedQueue<Unit*> monstersList = gamePtr->getEnemyList(ArmyType::ALIEN, UnitType::AM, monstersCapacity);
-
-    std::string foughtUnits = "";
+    TargetList dronesList;
+    TargetList monstersList;
+    gamePtr->getEnemyList(ArmyType::ALIEN, UnitType::AD, dronesCapacity, dronesList);
+    gamePtr->getEnemyList(ArmyType::ALIEN, UnitType::AM, monstersCapacity, monstersList);
 
     // Check for a successful attack
     bool attackCheck = false;
@@ -32,19 +27,8 @@ bool EarthGunnery::attack()
 
     while (dronesList.dequeue(enemyUnit) || monstersList.dequeue(enemyUnit))
     {
-        // Calculate the UAP and apply the damage
-        enemyUnit->receiveDamage(calcUAP(enemyUnit));
-
-        // Check if the unit is dead or can join the battle
-        if (enemyUnit->isDead())
-            gamePtr->addToKilledList(enemyUnit);
-        else
-            gamePtr->addUnit(enemyUnit);
-
-        // Store the IDs of the fought units to be printed later
-        if (foughtUnits != "")
-            foughtUnits += ", ";
-        foughtUnits += std::to_string(enemyUnit->getId());
+        // Damage the unit and send it to the list it belongs to
+        gamePtr->resolveShot(this, enemyUnit);
 
         // Nullify the pointer
         enemyUnit = nullptr;
@@ -53,13 +37,10 @@ bool EarthGunnery::attack()
         attackCheck = true;
     }
 
-    if (foughtUnits != "")
-        gamePtr->registerAttack(this, "shots", foughtUnits);
-
     return attackCheck;
 }
 
 int EarthGunnery::getPriority() const
 {
-    return (int) getHealth() + getPower();
+    return healthToInt(getHealth()) + getPower();
 }
\ No newline at end of file
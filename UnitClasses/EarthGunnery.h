@@ -7,9 +7,8 @@
 class EarthGunnery: public Unit
 {
 public:
-	EarthGunnery(Game*, double, int, int);
+	EarthGunnery(Game*, int, int, int);
 
-	void printUnit(); // Print the unit's type along with its ID
 	bool attack(); // Attack the enemy units
 
 	// Getters
@@ -1,27 +1,20 @@
 #include "EarthSoldier.h"
 #include "../Game.h"
-#include "../Containers/LinkedQueue.h"
+#include "../Containers/ArrayQueue.h"
 
-EarthSoldier::EarthSoldier(Game* gamePtr, double health, int power, int attackCapacity)
-    : HealableUnit(gamePtr, UnitType::ES, health, power, attackCapacity), infected(false), immune(false)
+EarthSoldier::EarthSoldier(Game* gamePtr, int health, int power, int attackCapacity)
+    : HealableUnit(gamePtr, UnitType::ES, health, power, attackCapacity)
 {}
 
-void EarthSoldier::printUnit()
-{
-    std::cout << "ES " << id;
-    if (infected)
-        std::cout << "*";
-}
-
 bool EarthSoldier::attack()
 {
-    std::string foughtUnits = "";
     // Check if the unit is infected and decide what to attack
     ArmyType enemyArmyType = isInfected() ? ArmyType::EARTH : ArmyType::ALIEN;
     UnitType enemyUnitType = isInfected() ? UnitType::ES : UnitType::AS;
 
     // Get the lists of units to attack
-    LinkedQueue<Unit*> enemyList = gamePtr->getEnemyList(enemyArmyType, enemyUnitType, attackCapacity);
+    TargetList enemyList;
+    gamePtr->getEnemyList(enemyArmyType, enemyUnitType, attackCapacity, enemyList);
 
     // Check for a successful attack
     bool attackCheck = false;
@@ -31,19 +24,8 @@ bool EarthSoldier::attack()
 
     while (enemyList.dequeue(enemyUnit))
     {
-        // Calculate the UAP and apply the damage
-        enemyUnit->receiveDamage(calcUAP(enemyUnit));
-
-        // Check if the unit is dead or can join the battle
-        if (enemyUnit->isDead())
-            gamePtr->addToKilledList(enemyUnit);
-        else
-            gamePtr->addUnit(enemyUnit);
-
-        // Store the IDs of the fought units to be printed later
-        if (foughtUnits != "")
-            foughtUnits += ", ";
-        foughtUnits += std::to_string(enemyUnit->getId());
+        // Damage the unit and send it to the list it belongs to
+        gamePtr->resolveShot(this, enemyUnit);
 
         // Nullify the pointer
         enemyUnit = nullptr;
@@ -52,9 +34,6 @@ bool EarthSoldier::attack()
         attackCheck = true;
     }
 
-    if (foughtUnits != "")
-        gamePtr->registerAttack(this, "shots", foughtUnits);
-
     return attackCheck;
 }
 
@@ -63,32 +42,35 @@ bool EarthSoldier::getInfection()
     if (isInfected() || isImmune())
         return false;
 
-    infected = true; // Set the infected flag to true
+    statusFlags |= StatusFlag::INFECTED; // Set the infected flag to true
+
+    // An immune soldier can't be infected again, so this is the soldier's first infection
+    gamePtr->registerFirstInfection();
 
     return true;
 }
 
 bool EarthSoldier::isInfected() const
 {
-    return infected;
+    return statusFlags & StatusFlag::INFECTED;
 }
 
 void EarthSoldier::loseInfection()
 {
-    infected = false; // Set the infected flag to false since the unit is healed
+    statusFlags &= ~StatusFlag::INFECTED; // Set the infected flag to false since the unit is healed
 }
 
 void EarthSoldier::gainImmunity()
 {
-    immune = true; // Set the immunity flag to true
+    statusFlags |= StatusFlag::IMMUNE; // Set the immunity flag to true
 }
 
 bool EarthSoldier::isImmune() const
 {
-    return immune;
+    return statusFlags & StatusFlag::IMMUNE;
 }
 
 int EarthSoldier::getHealPriority() const
 {
-    return 100 - (int) health; // The lower the health, the higher the priority
+    return 100 - healthToInt(health); // The lower the health, the higher the priority
 };
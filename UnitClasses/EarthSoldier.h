@@ -4,16 +4,12 @@
 #include "HealableUnit.h"
 #include "../DEFS.h"
 
+// The infection and immunity flags are kept in the unit's status flags
 class EarthSoldier: public HealableUnit
 {
-private:
-	bool infected; // If the soldier is infected or not
-	bool immune; // Indicates ability to catch infections
-
 public:
-	EarthSoldier(Game*, double, int, int);
+	EarthSoldier(Game*, int, int, int);
 
-	void printUnit(); // Print the unit's type along with its ID
 	bool attack(); // Attack the enemy units
 
 	// Infection and immunity functions
@@ -2,19 +2,12 @@
 
 #include "EarthTank.h"
 #include "../Game.h"
-#include "../Containers/LinkedQueue.h"
+#include "../Containers/ArrayQueue.h"
 
-bool EarthTank::isAttackingSoldiers = false;
-
-EarthTank::EarthTank(Game* gamePtr, double health, int power, int attackCapacity)
+EarthTank::EarthTank(Game* gamePtr, int health, int power, int attackCapacity)
     : HealableUnit(gamePtr, UnitType::ET, health, power, attackCapacity)
 {}
 
-void EarthTank::printUnit()
-{
-    std::cout << "ET " << id;
-}
-
 bool EarthTank::attack()
 {
     // If the tank is attacking soldiers, divide the attack capacity 50-50 between soldiers and monsters
@@ -22,10 +15,10 @@ bool EarthTank::attack()
     int monstersAttackCapacity = attackCapacity - soldiersAttackCapacity;
 
     // Get the lists of alien soldiers and monsters to attack
-    LinkedQueue<Unit*> monsterEnemyList = gamePtr->getEnemyList(ArmyType::ALIEN, UnitType::AM, monstersAttackCapacity);
-    LinkedQueue<Unit*> soldierEnemyList = gamePtr->getEnemyList(ArmyType::ALIEN, UnitType::AS, soldiersAttackCapacity);
-
-    std::string foughtUnits = "";
+    TargetList monsterEnemyList;
+    TargetList soldierEnemyList;
+    gamePtr->getEnemyList(ArmyType::ALIEN, UnitType::AM, monstersAttackCapacity, monsterEnemyList);
+    gamePtr->getEnemyList(ArmyType::ALIEN, UnitType::AS, soldiersAttackCapacity, soldierEnemyList);
 
     // Check for a successful attack
     bool attackCheck = false;
@@ -35,19 +28,8 @@ bool EarthTank::attack()
 
     while (monsterEnemyList.dequeue(enemyUnit) || soldierEnemyList.dequeue(enemyUnit))
     {
-        // Calculate the UAP and apply the damage
-        enemyUnit->receiveDamage(calcUAP(enemyUnit));
-
-        // Check if the unit is dead or can join the battle
-        if (enemyUnit->isDead())
-            gamePtr->addToKilledList(enemyUnit);
-        else
-            gamePtr->addUnit(enemyUnit);
-
-        // Store the IDs of the fought units to be printed later
-        if (foughtUnits != "")
-            foughtUnits += ", ";
-        foughtUnits += std::to_string(enemyUnit->getId());
+        // Damage the unit and send it to the list it belongs to
+        gamePtr->resolveShot(this, enemyUnit);
 
         // Nullify the pointer
         enemyUnit = nullptr;
@@ -56,22 +38,13 @@ bool EarthTank::attack()
         attackCheck = true;
     }
 
-    if (foughtUnits != "")
-        gamePtr->registerAttack(this, "shots", foughtUnits);
-
     return attackCheck;
 }
 
 bool EarthTank::willAttackSoldiers()
 {
-    float soldiersRatio = gamePtr->getUnitsCount(ALIEN, AS) > 0 ? (float) gamePtr->getUnitsCount(EARTH, ES) / gamePtr->getUnitsCount(ALIEN, AS) : -1;
-
-    if (soldiersRatio < 0.3 && soldiersRatio >= 0) // Attacks soldiers if the soldiers ration is below 30%
-        isAttackingSoldiers = true;
-    else if (soldiersRatio > 0.8) // Until it exceeds 80%
-        isAttackingSoldiers = false;
-
-    return isAttackingSoldiers;
+    // All the tanks of an army share the decision, so it's kept by the army
+    return gamePtr->doTanksAttackSoldiers();
 }
 
 int EarthTank::getHealPriority() const
@@ -6,13 +6,9 @@
 
 class EarthTank: public HealableUnit
 {
-private:
-	static bool isAttackingSoldiers; // A flag to check if the tank is attacking soldiers in the current timestep
-
 public:
-	EarthTank(Game*, double, int, int);
+	EarthTank(Game*, int, int, int);
 
-	void printUnit(); // Print the unit's type along with its ID
 	bool attack(); // Attack the enemy units
 
 	bool willAttackSoldiers(); // Check if the tank will attack soldiers in the current timestep
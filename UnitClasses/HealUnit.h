@@ -8,12 +8,9 @@
 class HealUnit: public Unit
 {
 public:
-	HealUnit(Game*, double, int, int);
+	HealUnit(Game*, int, int, int);
 
-	void printUnit(); // Print the unit's type along with its ID
 	bool attack(); // Heal units from the unit maintenance list
-
-	void healInfection(EarthSoldier*); // Heal the infection of the soldier
 };
 
 #endif
\ No newline at end of file
@@ -1,44 +1,47 @@
 #include "HealableUnit.h"
 #include "../Game.h"
 
-HealableUnit::HealableUnit(Game* gamePtr, UnitType unitType, double health, int power, int attackCapacity)
-    : Unit(gamePtr, unitType, health, power, attackCapacity), UMLjoinTime(-1), healedBefore(false)
+HealableUnit::HealableUnit(Game* gamePtr, UnitType unitType, int health, int power, int attackCapacity)
+    : Unit(gamePtr, unitType, health, power, attackCapacity)
 {}
 
 bool HealableUnit::needsHeal() const
 {
-    return (health / initialHealth) <= 0.2;
+    return isHealthCritical(health, initialHealth);
 }
 
 bool HealableUnit::hasWaitedForTooLong() const
 {
     // Check if it has spent more than 10 consecutive timesteps in the UML
-    return gamePtr->getCurrentTimestep() - UMLjoinTime > 10;
+    return gamePtr->getCurrentTimestep() - getLifecycle().UMLjoinTime > 10;
 }
 
 bool HealableUnit::isHealed() const
 {
     // A unit is healed if its health is more than 20% of its initial health
-    return health > initialHealth * 0.2;
+    return isHealthRecovered(health, initialHealth);
 }
 
 bool HealableUnit::hasBeenInUMLbefore() const
 {
-    return UMLjoinTime != -1;
+    return getLifecycle().UMLjoinTime != -1;
 }
 
 bool HealableUnit::hasBeenHealedBefore() const
 {
-    return healedBefore;
+    return getLifecycle().healedBefore;
 }
 
-void HealableUnit::receiveHeal(double UHP)
+void HealableUnit::receiveHeal(HealthValue UHP)
 {
     // Register that the unit has been healed before
-    healedBefore = true;
+    if (!getLifecycle().healedBefore)
+        gamePtr->registerFirstHeal();
 
-    // Infected units get twice the time to get healed
-    if (dynamic_cast<EarthSoldier*>(this) && dynamic_cast<EarthSoldier*>(this)->isInfected())
+    getLifecycle().healedBefore = true;
+
+    // Infected units get twice the time to get healed (only earth soldiers can be infected)
+    if (statusFlags & StatusFlag::INFECTED)
         health += UHP / 2;
     else
         health += UHP;
@@ -48,5 +51,5 @@ void HealableUnit::setUMLjoinTime(int UMLjoinTime)
 {
     // Check if it's the unit first time to join uml 
     if (!hasBeenInUMLbefore())
-        this->UMLjoinTime = UMLjoinTime;
+        getLifecycle().UMLjoinTime = UMLjoinTime;
 }
@@ -4,14 +4,11 @@
 #include "Unit.h"
 #include "../DEFS.h"
 
+// The UML join time and healing history are cold data kept in the unit's lifecycle record
 class HealableUnit: public Unit
 {
-protected:
-    int UMLjoinTime; // Time when the unit joined the UML
-    bool healedBefore; // Check if the unit has been healed before
-
 public:
-    HealableUnit(Game*, UnitType, double, int, int);
+    HealableUnit(Game*, UnitType, int, int, int);
 
     virtual int getHealPriority() const = 0; // Get the heal priority of the unit varies from one unit to another
 
@@ -21,10 +18,13 @@ public:
     bool hasBeenInUMLbefore() const; // Check if it has been inside uml before or not
     bool hasBeenHealedBefore() const; // Check if the unit has been healed before or not
 
-    void receiveHeal(double); // Increase the health of the unit by "UHP"
+    void receiveHeal(HealthValue); // Increase the health of the unit by "UHP"
 
     // Setters
     void setUMLjoinTime(int); // Set the time when the unit joined the UML
 };
 
+// Units picked from the UML for one heal
+typedef ArrayQueue<HealableUnit*, Unit::MAX_ATTACK_CAPACITY> HealTargetList;
+
 #endif
\ No newline at end of file
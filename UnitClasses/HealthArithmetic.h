@@ -0,0 +1,105 @@
+#ifndef HEALTH_ARITHMETIC_H
+#define HEALTH_ARITHMETIC_H
+
+// Health, UAP and heal amounts are doubles by default
+// Building with FIXED_POINT_HEALTH defined makes them fixed-point integers with a deterministic integer square root,
+// so battles are bit-identical across compilers and optimization levels
+#ifdef FIXED_POINT_HEALTH
+
+typedef int HealthValue; // Health in units of 1 / HEALTH_ONE
+
+enum { HEALTH_FRACTION_BITS = 16, HEALTH_ONE = 1 << HEALTH_FRACTION_BITS };
+enum { MAX_ATTACK_POINTS = 1000 * HEALTH_ONE }; // Caps a single UAP so health sums can't overflow
+
+inline long long integerSqrt(long long value) // Largest root with root * root <= value
+{
+	long long root = 0;
+	long long bit = 1LL << 62;
+
+	while (bit > value)
+		bit >>= 2;
+
+	while (bit)
+	{
+		if (value >= root + bit)
+		{
+			value -= root + bit;
+			root = (root >> 1) + bit;
+		}
+		else
+			root >>= 1;
+
+		bit >>= 2;
+	}
+
+	return root;
+}
+
+inline HealthValue healthFromInt(int value)
+{
+	return value * HEALTH_ONE;
+}
+
+inline int healthToInt(HealthValue value) // Truncates the fraction as a cast from double does
+{
+	return value / HEALTH_ONE;
+}
+
+inline HealthValue calcAttackPoints(int power, HealthValue attackerHealth, HealthValue receiverHealth)
+{
+	// (power * attackerHealth / 100) / sqrt(receiverHealth), the root keeps the fixed-point scale
+	long long numerator = (long long) power * attackerHealth / 100;
+	long long receiverRoot = integerSqrt((long long) receiverHealth << HEALTH_FRACTION_BITS);
+
+	if (receiverRoot == 0)
+		receiverRoot = 1;
+
+	long long attackPoints = (numerator << HEALTH_FRACTION_BITS) / receiverRoot;
+
+	return attackPoints > MAX_ATTACK_POINTS ? MAX_ATTACK_POINTS : (HealthValue) attackPoints;
+}
+
+inline bool isHealthCritical(HealthValue health, int initialHealth) // Health is at most 20% of the initial health
+{
+	return (long long) health * 5 <= (long long) initialHealth * HEALTH_ONE;
+}
+
+inline bool isHealthRecovered(HealthValue health, int initialHealth) // Health is more than 20% of the initial health
+{
+	return (long long) health * 5 > (long long) initialHealth * HEALTH_ONE;
+}
+
+#else
+
+#include <cmath>
+
+typedef double HealthValue;
+
+inline HealthValue healthFromInt(int value)
+{
+	return value;
+}
+
+inline int healthToInt(HealthValue value)
+{
+	return (int) value;
+}
+
+inline HealthValue calcAttackPoints(int power, HealthValue attackerHealth, HealthValue receiverHealth)
+{
+	return (power * attackerHealth / 100) / sqrt(receiverHealth);
+}
+
+inline bool isHealthCritical(HealthValue health, int initialHealth)
+{
+	return (health / initialHealth) <= 0.2;
+}
+
+inline bool isHealthRecovered(HealthValue health, int initialHealth)
+{
+	return health > initialHealth * 0.2;
+}
+
+#endif
+
+#endif
\ No newline at end of file
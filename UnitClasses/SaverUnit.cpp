@@ -3,21 +3,15 @@
 #include "SaverUnit.h"
 #include "../Game.h"
 
-SaverUnit::SaverUnit(Game* gamePtr, double health, int power, int attackCapacity)
+SaverUnit::SaverUnit(Game* gamePtr, int health, int power, int attackCapacity)
     : Unit(gamePtr, UnitType::SU, health, power, attackCapacity)
 {}
 
-void SaverUnit::printUnit()
-{
-    std::cout << "SU " << id;
-}
-
 bool SaverUnit::attack()
 {
     // Get the lists of alien soldiers to attack
-    LinkedQueue<Unit*> enemyList = gamePtr->getEnemyList(ArmyType::ALIEN, UnitType::AS, attackCapacity);
-
-    std::string foughtUnits = "";
+    TargetList enemyList;
+    gamePtr->getEnemyList(ArmyType::ALIEN, UnitType::AS, attackCapacity, enemyList);
 
     // Check for a successful attack
     bool attackCheck = false;
@@ -27,19 +21,8 @@ bool SaverUnit::attack()
 
     while (enemyList.dequeue(enemyUnit))
     {
-        // Calculate the UAP and apply the damage
-        enemyUnit->receiveDamage(calcUAP(enemyUnit));
-
-        // Check if the unit is dead or can join the battle
-        if (enemyUnit->isDead())
-            gamePtr->addToKilledList(enemyUnit);
-        else
-            gamePtr->addUnit(enemyUnit);
-
-        // Store the IDs of the fought units to be printed later
-        if (foughtUnits != "")
-            foughtUnits += ", ";
-        foughtUnits += std::to_string(enemyUnit->getId());
+        // Damage the unit and send it to the list it belongs to
+        gamePtr->resolveShot(this, enemyUnit);
 
         // Nullify the pointer
         enemyUnit = nullptr;
@@ -48,8 +31,5 @@ bool SaverUnit::attack()
         attackCheck = true;
     }
 
-    if (foughtUnits != "")
-        gamePtr->registerAttack(this, "shots", foughtUnits);
-
     return attackCheck;
 }
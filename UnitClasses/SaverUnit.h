@@ -7,9 +7,8 @@
 class SaverUnit: public Unit
 {
 public:
-	SaverUnit(Game*, double, int, int);
+	SaverUnit(Game*, int, int, int);
 
-	void printUnit(); // Print the unit's type along with its ID
 	bool attack(); // Attack the enemy units
 };
 
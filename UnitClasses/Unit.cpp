@@ -1,79 +1,75 @@
-#include <cmath>
-
 #include "Unit.h"
 #include "../Game.h"
 
-int Unit::nextEarthId = 1;
-int Unit::nextAlienId = 2000;
-int Unit::nextEarthAlliedId = 4000;
+static_assert(sizeof(Unit) <= 32, "The unit's hot record should fit in half a cache line");
 
-Unit::Unit(Game* gamePtr, UnitType unitType, double health, int power, int attackCapacity)
-	: gamePtr(gamePtr), unitType(unitType), Ta(-1), Td(-1), power(power), attackCapacity(attackCapacity)
+Unit::Unit(Game* gamePtr, UnitType unitType, int health, int power, int attackCapacity)
+	: gamePtr(gamePtr), unitType(unitType), statusFlags(0)
 {
-	// Set the unit's health
+	// Set the unit's stats
 	setHealth(health);
+	setPower(power);
+	setAttackCapacity(attackCapacity);
 
-	// Set the unit's ID and army type
-	if (unitType == UnitType::ES || unitType == UnitType::EG || unitType == UnitType::ET || unitType == UnitType::EH)
-	{
-		id = nextEarthId++;
-		armyType = ArmyType::EARTH;
-	}
-	else if (unitType == UnitType::SU)
-	{
-		id = nextEarthAlliedId++;
-		armyType = ArmyType::EARTH_ALLIED;
-	}
-	else
-	{
-		id = nextAlienId++;
-		armyType = ArmyType::ALIEN;
-	}
+	// Set the unit's ID (each game numbers its own units)
+	id = gamePtr->generateUnitId(getArmyType(unitType));
 
-	// Set the unit's join time
-	Tj = gamePtr->getCurrentTimestep();
+	// Start the unit's lifecycle record (sets the join time)
+	gamePtr->registerUnit(this);
 }
 
-bool Unit::cantCreateEarthUnit()
+void Unit::setHealth(int health)
 {
-	return nextEarthId > MAX_EARTH_ID;
-}
+	// Check if the health value is within the range [1, 100]
+	if (health < 1)
+		health = 1;
+	if (health > 100)
+		health = 100;
 
-bool Unit::cantCreateAlienUnit()
-{
-	return nextAlienId > MAX_ALIEN_ID;
+	this->initialHealth = health; // Save the initial health value for healing purposes
+	this->health = healthFromInt(health); // Set the current health value
 }
 
-bool Unit::cantCreateEarthAlliedUnit()
+void Unit::setPower(int power)
 {
-	return nextEarthAlliedId > MAX_EARTH_ALLIED_ID;
+	// Check if the power value is within the range [0, MAX_POWER]
+	if (power < 0)
+		power = 0;
+	if (power > MAX_POWER)
+		power = MAX_POWER;
+
+	this->power = power;
 }
 
-void Unit::setHealth(double health)
+void Unit::setAttackCapacity(int attackCapacity)
 {
-	// Check if the health value is within the range [1, 100]
-	if (health < 1)
-		health = 1;
-	if (health > 100)
-		health = 100;
+	// Check if the attack capacity value is within the range [0, MAX_ATTACK_CAPACITY]
+	if (attackCapacity < 0)
+		attackCapacity = 0;
+	if (attackCapacity > MAX_ATTACK_CAPACITY)
+		attackCapacity = MAX_ATTACK_CAPACITY;
 
-	this->initialHealth = health; // Save the initial health value for healing purposes
-	this->health = health; // Set the current health value
+	this->attackCapacity = attackCapacity;
 }
 
-double Unit::calcUAP(Unit* receivingUnit) const
+HealthValue Unit::calcUAP(Unit* receivingUnit) const
 {
-	return (power * health / 100) / sqrt(receivingUnit->health);
+	return calcAttackPoints(power, health, receivingUnit->health);
 }
 
-void Unit::receiveDamage(double UAP)
+void Unit::receiveDamage(HealthValue UAP)
 {
 	// Decrement the unit's health, force it to its minimum value if it exceeded it
 	health = health - UAP > 0 ? health - UAP : 0;
 
 	// Check if it's the unit's first time being attacked and set it if needed
 	if (!hasBeenAttackedBefore())
-		Ta = gamePtr->getCurrentTimestep();
+	{
+		statusFlags |= StatusFlag::ATTACKED_BEFORE;
+#ifndef OUTCOME_ONLY
+		getLifecycle().Ta = gamePtr->getCurrentTimestep();
+#endif
+	}
 }
 
 bool Unit::needsHeal() const
@@ -88,7 +84,13 @@ bool Unit::isDead() const
 
 bool Unit::hasBeenAttackedBefore() const
 {
-	return Ta != -1;
+	return statusFlags & StatusFlag::ATTACKED_BEFORE;
+}
+
+void Unit::restoreState(HealthValue health, unsigned char statusFlags)
+{
+	this->health = health;
+	this->statusFlags = statusFlags;
 }
 
 int Unit::getId() const
@@ -96,9 +98,28 @@ int Unit::getId() const
 	return id;
 }
 
+ArmyType Unit::getArmyType(UnitType unitType)
+{
+	switch (unitType)
+	{
+		case UnitType::ES:
+		case UnitType::EG:
+		case UnitType::ET:
+		case UnitType::EH:
+			return ArmyType::EARTH;
+
+		case UnitType::SU:
+			return ArmyType::EARTH_ALLIED;
+
+		default:
+			return ArmyType::ALIEN;
+	}
+}
+
 ArmyType Unit::getArmyType() const
 {
-	return armyType;
+	// The army type is derived from the unit type instead of being stored
+	return getArmyType(unitType);
 }
 
 UnitType Unit::getUnitType() const
@@ -106,7 +127,7 @@ UnitType Unit::getUnitType() const
 	return unitType;
 }
 
-double Unit::getHealth() const
+HealthValue Unit::getHealth() const
 {
 	return health;
 }
@@ -116,41 +137,66 @@ int Unit::getPower() const
 	return power;
 }
 
+unsigned char Unit::getStatusFlags() const
+{
+	return statusFlags;
+}
+
+UnitSpec Unit::getSpec() const
+{
+	UnitSpec unitSpec = { unitType, initialHealth, power, attackCapacity };
+	return unitSpec;
+}
+
+const UnitLifecycle& Unit::getLifecycle() const
+{
+	return gamePtr->getUnitLifecycle(id);
+}
+
+UnitLifecycle& Unit::getLifecycle()
+{
+	return gamePtr->getUnitLifecycle(id);
+}
+
+#ifndef OUTCOME_ONLY
 int Unit::getJoinTime() const
 {
-	return Tj;
+	return getLifecycle().Tj;
 }
 
 int Unit::getDestructionTime() const
 {
-	return Td;
+	return getLifecycle().Td;
 }
 
 int Unit::getFirstAttackDelay() const
 {
-	return hasBeenAttackedBefore() ? Ta - Tj : -1;
+	const UnitLifecycle& lifecycle = getLifecycle();
+	return hasBeenAttackedBefore() ? lifecycle.Ta - lifecycle.Tj : -1;
 }
 
 int Unit::getDestructionDelay() const
 {
-	return isDead() ? Td - Ta : -1;
+	const UnitLifecycle& lifecycle = getLifecycle();
+	return isDead() ? lifecycle.Td - lifecycle.Ta : -1;
 }
 
 int Unit::getBattleDelay() const
 {
-	return isDead() ? Td - Tj : -1;
+	const UnitLifecycle& lifecycle = getLifecycle();
+	return isDead() ? lifecycle.Td - lifecycle.Tj : -1;
 }
 
 void Unit::setDestructionTime(int Td)
 {
-	this->Td = Td;
+	getLifecycle().Td = Td;
 }
+#endif
 
 std::ostream& operator<<(std::ostream& oStream, Unit* unitObj)
 {
 	oStream << unitObj->id;
-	EarthSoldier* ESunit = dynamic_cast<EarthSoldier*>(unitObj);
-	if (ESunit && ESunit->isInfected())
+	if (unitObj->statusFlags & Unit::StatusFlag::INFECTED) // Only earth soldiers can be infected
 	{
 		oStream << "*";
 	}
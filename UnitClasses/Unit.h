@@ -5,64 +5,67 @@
 
 #include "../DEFS.h"
 #include "../Containers/LinkedQueue.h"
+#include "../Containers/ArrayQueue.h"
+#include "HealthArithmetic.h"
 
 class Game;
 
+// A unit only holds the fields needed while fighting (hot record of at most 32 bytes)
+// Its lifecycle times and healing history are kept in the game's side table indexed by the unit's ID
 class Unit
 {
-private:
-	enum { MAX_EARTH_ID = 999, MAX_ALIEN_ID = 2999, MAX_EARTH_ALLIED_ID = 4999 }; // Maximum ID values for each army type
-
-	static int nextEarthId;
-	static int nextAlienId;
-	static int nextEarthAlliedId;
+public:
+	enum { MAX_POWER = 10000, MAX_ATTACK_CAPACITY = 100 }; // Maximum values that fit in the compact fields
 
 protected:
+	enum StatusFlag { ATTACKED_BEFORE = 1, INFECTED = 2, IMMUNE = 4 }; // Bits of statusFlags
+
 	Game* gamePtr;
-	int id;
 
-	ArmyType armyType;
+	HealthValue health; // Current health
+	short id;
+	short power; // Attack power
+	unsigned char attackCapacity; // Attack capacity
+	unsigned char initialHealth; // Initial health (a whole number in the range [1, 100])
 	UnitType unitType;
-
-	int Tj; // Join time
-	int Ta; // First attack time
-	int Td; // Destruction time
-
-	double initialHealth; // Initial health
-	double health; // Current health
-	int power; // Attack power
-	int attackCapacity; // Attack capacity
+	unsigned char statusFlags; // Combination of StatusFlag bits
 
 private:
-	void setHealth(double); // Health setter with range check & initial health saving to be used in constructor
+	void setHealth(int); // Health setter with range check & initial health saving to be used in constructor
+	void setPower(int); // Power setter with range check to be used in constructor
+	void setAttackCapacity(int); // Attack capacity setter with range check to be used in constructor
 
 protected:
-	double calcUAP(Unit*) const; // Calculates the damage caused when attacked by "attackerUnit"
+	HealthValue calcUAP(Unit*) const; // Calculates the damage caused when attacked by "attackerUnit"
+
+	const UnitLifecycle& getLifecycle() const; // Get the unit's record from the game's side table
+	UnitLifecycle& getLifecycle();
 
 public:
-	Unit(Game*, UnitType, double, int, int);
+	Unit(Game*, UnitType, int, int, int);
 
 	// Static functions
-	static bool cantCreateEarthUnit(); // Check if the max number of earth units is reached
-	static bool cantCreateAlienUnit(); // Check if the max number of alien units is reached
-	static bool cantCreateEarthAlliedUnit(); // Check if the max number of allied units is reached
+	static ArmyType getArmyType(UnitType); // Get the army a unit type belongs to
 
-	void receiveDamage(double); // Decrease the health of the unit by "UAP"
+	void receiveDamage(HealthValue); // Decrease the health of the unit by "UAP"
 
 	virtual bool attack() = 0; // Attack the enemy units
-	virtual void printUnit() = 0; // Print the unit's type along with its ID
 
 	virtual bool needsHeal() const; // Check if the unit is eligible for healing
 	bool isDead() const; // Check if the unit is dead
 	bool hasBeenAttackedBefore() const; // Check if it has been attacked before
+	void restoreState(HealthValue, unsigned char); // Continue from the health and status bits saved in a checkpoint
 
 	// Getters
 	int getId() const;
 	ArmyType getArmyType() const;
 	UnitType getUnitType() const;
-	double getHealth() const;
+	HealthValue getHealth() const;
 	int getPower() const;
+	unsigned char getStatusFlags() const; // Get the status bits (attacked before, infected, immune)
+	UnitSpec getSpec() const; // Get the type and stats the unit was generated with
 
+#ifndef OUTCOME_ONLY
 	// Time Getters
 	int getJoinTime() const;
 	int getDestructionTime() const;
@@ -74,8 +77,12 @@ public:
 
 	// Setters
 	void setDestructionTime(int);
+#endif
 
 	friend std::ostream& operator<<(std::ostream&, Unit*); // Print the unit's ID
 };
 
+// Targets picked for one attack, an attack never picks more units than the maximum attack capacity
+typedef ArrayQueue<Unit*, Unit::MAX_ATTACK_CAPACITY> TargetList;
+
 #endif
\ No newline at end of file
@@ -11,9 +11,6 @@ std::string getUserOutputFileChoice(); // Asks the user to choose the output fil
 
 int main()
 {
-    // Seed the random number generator
-    srand((unsigned) time(NULL));
-
     // Display welcome messages
     displayWelcomeMessage();
 
@@ -28,6 +25,7 @@ int main()
 
     // Start the game (made on the heap to avoid stack overflow since the game object is large)
     Game* game = new Game;
+    game->setSeed((unsigned) time(NULL)); // Seed the game's random number generator
     game->run(gameMode, "InputFiles/" + inputFileName + ".txt", outputFileName + ".txt");
 
     // Delete the game object